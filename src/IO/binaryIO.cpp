@@ -8,19 +8,26 @@
 
 
 
-// save an eigen matrix into a binary file
-void saveMatrixBin(std::string filename, const CDMatrix& m) {
+// save rows x cols complex numbers into a binary file
+static void saveComplexBin(std::string filename, int rows, int cols, const dcomplex* data) {
 	std::ofstream f(filename.c_str(), std::ios::binary);
 	// write the row_count and col_count into the file
-	int rows = m.rows();
-	int cols = m.cols();
 	f.write((char *)&rows, sizeof(rows));
 	f.write((char *)&cols, sizeof(cols));
 	// write the matrix elements into the file
-	f.write((char *)m.data(), sizeof(dcomplex)*rows*cols);
+	f.write((char *)data, sizeof(dcomplex)*rows*cols);
 	f.close();
 }
 
+// save an eigen matrix into a binary file
+void saveMatrixBin(std::string filename, const CDMatrix& m) {
+	saveComplexBin(filename, m.rows(), m.cols(), m.data());
+}
+
+void saveMatrixBin(std::string filename, const CDMatrixMap& m) {
+	saveComplexBin(filename, m.rows(), m.cols(), m.data());
+}
+
 // load an eigen matrix from a binary file
 void loadMatrixBin(std::string filename, CDMatrix& m) {
 	int rows, cols;
@@ -17,6 +17,7 @@
 
 
 void saveMatrixBin(std::string filename, const CDMatrix& m);
+void saveMatrixBin(std::string filename, const CDMatrixMap& m);
 void loadMatrixBin(std::string filename, CDMatrix& m);
 
 void saveMatrixBin(std::string filename, const DMatrix& m);
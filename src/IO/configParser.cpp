@@ -0,0 +1,269 @@
+/*
+ * configParser.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "configParser.h"
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+
+/**
+ * convert the whole string to a double; return false if there is anything
+ * left after the number
+ */
+static bool toDouble(std::string s, double& x) {
+	if (s.empty()) return false;
+	char* end;
+	x = strtod(s.c_str(), &end);
+	return *end == '\0';
+}
+
+
+static bool toBool(std::string s, bool& b) {
+	std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+	if (s=="true" || s=="1") {
+		b = true;
+		return true;
+	}
+	if (s=="false" || s=="0") {
+		b = false;
+		return true;
+	}
+	return false;
+}
+
+
+bool expandSweep(std::string value, bool integer, std::vector<double>& values) {
+	// no sweep should be longer than this (protects against a tiny step)
+	const int maxValues = 1000000;
+	values.clear();
+	std::stringstream items(value);
+	std::string item;
+	while (getline(items, item, ',')) {
+		std::vector<std::string> parts;
+		std::stringstream fields(item);
+		std::string field;
+		while (getline(fields, field, ':')) {
+			parts.push_back(field);
+		}
+		if (parts.size()==1) {
+			double x;
+			if (!toDouble(parts[0], x)) return false;
+			values.push_back(x);
+		} else if (parts.size()==3) {
+			double start, step, stop;
+			if (!toDouble(parts[0], start) || !toDouble(parts[1], step)
+					|| !toDouble(parts[2], stop)) {
+				return false;
+			}
+			if (step==0.0 || (stop-start)*step < 0.0) return false;
+			// the small tolerance keeps stop when (stop-start)/step is not exact
+			int num = (int) std::floor((stop-start)/step + 1.e-9) + 1;
+			if (num > maxValues) return false;
+			for (int i=0; i<num; ++i) {
+				values.push_back(start + i*step);
+			}
+		} else {
+			return false;
+		}
+		if (values.size() > maxValues) return false;
+	}
+	if (values.empty()) return false;
+
+	if (integer) {
+		for (int i=0; i<values.size(); ++i) {
+			// ranges like 1:1:5 may accumulate rounding errors
+			double rounded = std::floor(values[i] + 0.5);
+			if (std::abs(values[i]-rounded) > 1.e-9) return false;
+			values[i] = rounded;
+		}
+	}
+	return true;
+}
+
+
+bool InputConfig::parse(std::istream& in, std::string& error) {
+	table.clear();
+	std::string line;
+	int lineNumber = 0;
+	while (getline(in, line)) {
+		++lineNumber;
+		std::istringstream iss(line);
+		std::string type, name, value, extra;
+		if (!(iss >> type) || type[0]=='#') continue;
+
+		if (type!="int" && type!="unsigned" && type!="double" && type!="bool"
+				&& type!="string") {
+			std::cout << source << ":" << lineNumber << ": ignore \"" << line
+					  << "\"" << std::endl;
+			continue;
+		}
+
+		std::ostringstream where;
+		where << source << ":" << lineNumber << ": ";
+		if (!(iss >> name >> value)) {
+			error = where.str() + "expected \"" + type + " name value\"";
+			return false;
+		}
+		if (iss >> extra && extra[0]!='#') {
+			error = where.str() + "unexpected \"" + extra + "\" after the value";
+			return false;
+		}
+		if (has(name)) {
+			std::ostringstream previous;
+			previous << table[name].line;
+			error = where.str() + name + " is already defined in line " + previous.str();
+			return false;
+		}
+
+		ConfigEntry entry;
+		entry.type = type;
+		entry.value = value;
+		entry.line = lineNumber;
+		if (type=="int" || type=="unsigned" || type=="double") {
+			if (!expandSweep(value, type!="double", entry.values)) {
+				error = where.str() + "invalid " + type + " value \"" + value + "\"";
+				return false;
+			}
+			if (type=="unsigned"
+					&& *std::min_element(entry.values.begin(), entry.values.end()) < 0) {
+				error = where.str() + "negative unsigned value \"" + value + "\"";
+				return false;
+			}
+		} else if (type=="bool") {
+			bool b;
+			if (!toBool(value, b)) {
+				error = where.str() + "invalid bool value \"" + value + "\"";
+				return false;
+			}
+		}
+		table[name] = entry;
+	}
+	return true;
+}
+
+
+void InputConfig::read(std::string filename) {
+	std::ifstream in(filename.c_str());
+	if (!in) {
+		std::cout << "Cannot open the input file " << filename << std::endl;
+		exit(-1);
+	}
+	source = filename;
+	std::string error;
+	if (!parse(in, error)) {
+		std::cout << error << std::endl;
+		exit(-1);
+	}
+	in.close();
+}
+
+
+bool InputConfig::isSweep(std::string name) const {
+	std::map<std::string, ConfigEntry>::const_iterator it = table.find(name);
+	return it != table.end() && it->second.values.size() > 1;
+}
+
+
+/**
+ * the entry of the variable, NULL if it is not in the file; stop the program
+ * if it has a different type
+ */
+const ConfigEntry* InputConfig::find(std::string name, std::string type) const {
+	std::map<std::string, ConfigEntry>::const_iterator it = table.find(name);
+	if (it == table.end()) return NULL;
+	if (it->second.type != type) {
+		std::cout << source << ":" << it->second.line << ": " << name
+				  << " must be " << type << " instead of " << it->second.type
+				  << std::endl;
+		exit(-1);
+	}
+	return &(it->second);
+}
+
+
+const ConfigEntry* InputConfig::findSingle(std::string name, std::string type) const {
+	const ConfigEntry* entry = find(name, type);
+	if (entry != NULL && entry->values.size() > 1) {
+		std::cout << source << ":" << entry->line << ": " << name
+				  << " cannot be a sweep" << std::endl;
+		exit(-1);
+	}
+	return entry;
+}
+
+
+int InputConfig::getInt(std::string name, int defaultValue) const {
+	const ConfigEntry* entry = findSingle(name, "int");
+	return entry==NULL ? defaultValue : (int) entry->values[0];
+}
+
+
+unsigned InputConfig::getUnsigned(std::string name, unsigned defaultValue) const {
+	const ConfigEntry* entry = findSingle(name, "unsigned");
+	return entry==NULL ? defaultValue : (unsigned) entry->values[0];
+}
+
+
+double InputConfig::getDouble(std::string name, double defaultValue) const {
+	const ConfigEntry* entry = findSingle(name, "double");
+	return entry==NULL ? defaultValue : entry->values[0];
+}
+
+
+bool InputConfig::getBool(std::string name, bool defaultValue) const {
+	const ConfigEntry* entry = find(name, "bool");
+	if (entry==NULL) return defaultValue;
+	bool b;
+	toBool(entry->value, b);
+	return b;
+}
+
+
+std::string InputConfig::getString(std::string name, std::string defaultValue) const {
+	const ConfigEntry* entry = find(name, "string");
+	return entry==NULL ? defaultValue : entry->value;
+}
+
+
+std::vector<int> InputConfig::getIntList(std::string name, int defaultValue) const {
+	const ConfigEntry* entry = find(name, "int");
+	std::vector<int> list;
+	if (entry==NULL) {
+		list.push_back(defaultValue);
+	} else {
+		for (int i=0; i<entry->values.size(); ++i) {
+			list.push_back((int) entry->values[i]);
+		}
+	}
+	return list;
+}
+
+
+std::vector<unsigned> InputConfig::getUnsignedList(std::string name,
+		unsigned defaultValue) const {
+	const ConfigEntry* entry = find(name, "unsigned");
+	std::vector<unsigned> list;
+	if (entry==NULL) {
+		list.push_back(defaultValue);
+	} else {
+		for (int i=0; i<entry->values.size(); ++i) {
+			list.push_back((unsigned) entry->values[i]);
+		}
+	}
+	return list;
+}
+
+
+std::vector<double> InputConfig::getDoubleList(std::string name,
+		double defaultValue) const {
+	const ConfigEntry* entry = find(name, "double");
+	if (entry==NULL) {
+		return std::vector<double>(1, defaultValue);
+	}
+	return entry->values;
+}
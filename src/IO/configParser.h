@@ -0,0 +1,98 @@
+/*
+ * configParser.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Read an input file in the "type name value" format of input.txt once into
+ * a typed table (READ_INPUT rescans the whole file for every variable).
+ *
+ * The value of a numeric variable (int, unsigned, double) may be a sweep:
+ * a comma separated list of items, where every item is either a number or
+ * an inclusive range start:step:stop, for example
+ *
+ *   unsigned seed 1:1:50
+ *   double E -1.0,0.0,0.5:0.25:1.0
+ *
+ * Blank lines and lines starting with # are skipped. A line whose first
+ * word is not a type is reported and ignored (as READ_INPUT does), while a
+ * bad value or a variable defined twice is an error.
+ */
+
+#ifndef CONFIGPARSER_H_
+#define CONFIGPARSER_H_
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+
+
+typedef struct {
+	std::string type;
+	std::string value; // as written in the file
+	std::vector<double> values; // the expanded values of a numeric variable
+	int line;
+} ConfigEntry;
+
+
+class InputConfig {
+public:
+	InputConfig() {}
+
+	/**
+	 * parse the input file; stop the program if the file is invalid
+	 */
+	void read(std::string filename);
+
+	/**
+	 * parse the content of a stream; return false and the reason in error if
+	 * the content is invalid
+	 */
+	bool parse(std::istream& in, std::string& error);
+
+	bool has(std::string name) const {
+		return table.find(name) != table.end();
+	}
+
+	// true if a numeric variable has more than one value
+	bool isSweep(std::string name) const;
+
+	/**
+	 * the value of a variable (defaultValue if it is not in the file); the
+	 * program stops if the type in the file is different or if the variable
+	 * is a sweep
+	 */
+	int getInt(std::string name, int defaultValue) const;
+	unsigned getUnsigned(std::string name, unsigned defaultValue) const;
+	double getDouble(std::string name, double defaultValue) const;
+	bool getBool(std::string name, bool defaultValue) const;
+	std::string getString(std::string name, std::string defaultValue) const;
+
+	/**
+	 * all the values of a (possibly sweep) variable
+	 */
+	std::vector<int> getIntList(std::string name, int defaultValue) const;
+	std::vector<unsigned> getUnsignedList(std::string name, unsigned defaultValue) const;
+	std::vector<double> getDoubleList(std::string name, double defaultValue) const;
+
+	const std::map<std::string, ConfigEntry>& getTable() const { return table; }
+
+private:
+	const ConfigEntry* find(std::string name, std::string type) const;
+	const ConfigEntry* findSingle(std::string name, std::string type) const;
+
+	std::string source;
+	std::map<std::string, ConfigEntry> table;
+};
+
+
+/**
+ * expand a sweep (see above) into its values; return false if it is invalid
+ * or if integer is true and a value is not an integer
+ */
+bool expandSweep(std::string value, bool integer, std::vector<double>& values);
+
+#endif /* CONFIGPARSER_H_ */
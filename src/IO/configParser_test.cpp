@@ -0,0 +1,92 @@
+/*
+ * configParser_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "configParser.h"
+
+
+TEST(ConfigParserTest, TypedTable) {
+	std::istringstream in(
+			"# a comment\n"
+			"int xmax 101\n"
+			"double onsiteE 2.5\n"
+			"\n"
+			"more random string: agn;ahy;$264r3\n"
+			"bool randomOnsite TRUE\n"
+			"unsigned seed 100\n"
+			"string engine direct\n");
+	InputConfig config;
+	std::string error;
+	ASSERT_TRUE(config.parse(in, error));
+
+	EXPECT_EQ(config.getInt("xmax", 0), 101);
+	EXPECT_DOUBLE_EQ(config.getDouble("onsiteE", 0.0), 2.5);
+	EXPECT_TRUE(config.getBool("randomOnsite", false));
+	EXPECT_EQ(config.getUnsigned("seed", 0), 100);
+	EXPECT_EQ(config.getString("engine", "recursive"), "direct");
+	// missing variables take the default value
+	EXPECT_FALSE(config.has("hop"));
+	EXPECT_DOUBLE_EQ(config.getDouble("hop", 1.5), 1.5);
+	EXPECT_FALSE(config.isSweep("xmax"));
+}
+
+
+TEST(ConfigParserTest, Sweeps) {
+	std::vector<double> values;
+	ASSERT_TRUE(expandSweep("1:1:5", true, values));
+	ASSERT_EQ(values.size(), 5);
+	EXPECT_DOUBLE_EQ(values[4], 5.0);
+
+	ASSERT_TRUE(expandSweep("-1.0,0.0,0.5:0.25:1.0", false, values));
+	ASSERT_EQ(values.size(), 5);
+	EXPECT_DOUBLE_EQ(values[0], -1.0);
+	EXPECT_DOUBLE_EQ(values[3], 0.75);
+	EXPECT_DOUBLE_EQ(values[4], 1.0);
+
+	// decreasing range and a step that does not divide the interval
+	ASSERT_TRUE(expandSweep("0.3:-0.1:0.0", false, values));
+	EXPECT_EQ(values.size(), 4);
+	ASSERT_TRUE(expandSweep("0:0.4:1", false, values));
+	EXPECT_EQ(values.size(), 3);
+
+	EXPECT_FALSE(expandSweep("1:0:5", false, values));
+	EXPECT_FALSE(expandSweep("5:1:1", false, values));
+	EXPECT_FALSE(expandSweep("1.5", true, values));
+	EXPECT_FALSE(expandSweep("1:2", false, values));
+	EXPECT_FALSE(expandSweep("abc", false, values));
+
+	std::istringstream in("unsigned seed 1:1:10\ndouble E -1,1\n");
+	InputConfig config;
+	std::string error;
+	ASSERT_TRUE(config.parse(in, error));
+	EXPECT_TRUE(config.isSweep("seed"));
+	EXPECT_EQ(config.getUnsignedList("seed", 0).size(), 10);
+	EXPECT_EQ(config.getDoubleList("E", 0.0).size(), 2);
+	EXPECT_EQ(config.getIntList("xmax", 7)[0], 7);
+}
+
+
+TEST(ConfigParserTest, Validation) {
+	InputConfig config;
+	std::string error;
+
+	std::istringstream duplicate("int xmax 10\nint xmax 20\n");
+	EXPECT_FALSE(config.parse(duplicate, error));
+	EXPECT_NE(error.find("already defined in line 1"), std::string::npos);
+
+	std::istringstream badInt("int xmax 10.5\n");
+	EXPECT_FALSE(config.parse(badInt, error));
+
+	std::istringstream badBool("bool randomHop maybe\n");
+	EXPECT_FALSE(config.parse(badBool, error));
+
+	std::istringstream negative("unsigned seed -1\n");
+	EXPECT_FALSE(config.parse(negative, error));
+
+	std::istringstream missing("double eta\n");
+	EXPECT_FALSE(config.parse(missing, error));
+}
@@ -0,0 +1,287 @@
+/*
+ * spillStore.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "spillStore.h"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdint.h>
+#include <zlib.h>
+#include "../Utility/misc.h"
+#include "../Utility/blockMemory.h"
+
+
+// header: rows, cols, codec, mantissa bits
+static const int RAW = 0;
+static const int DEFLATE = 1;
+
+
+/**
+ * round the mantissa of x to its first bits bits (Inf and NaN are kept)
+ */
+static double roundMantissa(double x, int bits) {
+	uint64_t u;
+	std::memcpy(&u, &x, sizeof(u));
+	const uint64_t exponentMask = ((uint64_t) 0x7ff) << 52;
+	if ((u & exponentMask) == exponentMask) return x;
+	int drop = 52 - bits;
+	u += ((uint64_t) 1) << (drop-1);
+	u &= ~((((uint64_t) 1) << drop) - 1);
+	std::memcpy(&x, &u, sizeof(u));
+	return x;
+}
+
+
+void encodeBlock(const CDMatrix& m, double tolerance, std::vector<char>& bytes) {
+	int header[4] = {(int) m.rows(), (int) m.cols(), RAW, 52};
+	long size = m.size()*sizeof(dcomplex);
+	const char* data = (const char*) m.data();
+	if (tolerance < 0.0) {
+		bytes.resize(sizeof(header) + size);
+		std::memcpy(&bytes[0], header, sizeof(header));
+		if (size > 0) std::memcpy(&bytes[sizeof(header)], data, size);
+		return;
+	}
+
+	header[2] = DEFLATE;
+	long numDoubles = 2*m.size();
+	std::vector<double> values(numDoubles);
+	if (numDoubles > 0) std::memcpy(&values[0], data, size);
+	if (tolerance > 0.0) {
+		int bits = (int) std::ceil(-std::log(tolerance)/std::log(2.0));
+		header[3] = std::max(1, std::min(bits, 52));
+		if (header[3] < 52) {
+			for (long i=0; i<numDoubles; ++i) values[i] = roundMantissa(values[i], header[3]);
+		}
+	}
+
+	// byte k of double i goes to k*numDoubles + i
+	std::vector<unsigned char> shuffled(std::max(size, 1L));
+	const unsigned char* raw = numDoubles > 0 ? (const unsigned char*) &values[0] : NULL;
+	for (long i=0; i<numDoubles; ++i) {
+		for (int k=0; k<sizeof(double); ++k) {
+			shuffled[k*numDoubles + i] = raw[i*sizeof(double) + k];
+		}
+	}
+
+	// the shuffled planes are long runs or noise, so run-length matching is
+	// enough and about three times faster than the default string matching
+	z_stream stream;
+	stream.zalloc = Z_NULL;
+	stream.zfree = Z_NULL;
+	stream.opaque = Z_NULL;
+	uLong compressedSize = compressBound(size);
+	bytes.resize(sizeof(header) + compressedSize);
+	int status = deflateInit2(&stream, 1, Z_DEFLATED, 15, 8, Z_RLE);
+	if (status == Z_OK) {
+		stream.next_in = &shuffled[0];
+		stream.avail_in = size;
+		stream.next_out = (Bytef*) &bytes[sizeof(header)];
+		stream.avail_out = compressedSize;
+		status = deflate(&stream, Z_FINISH);
+		compressedSize = stream.total_out;
+		deflateEnd(&stream);
+	}
+	if (status != Z_STREAM_END) {
+		std::cout << "Failed to compress a block (zlib error " << status << ")" << std::endl;
+		exit(-1);
+	}
+	bytes.resize(sizeof(header) + compressedSize);
+	std::memcpy(&bytes[0], header, sizeof(header));
+}
+
+
+void decodeBlock(const std::vector<char>& bytes, CDMatrix& m) {
+	int header[4];
+	std::memcpy(header, &bytes[0], sizeof(header));
+	allocateMatrix(m, header[0], header[1]);
+	long size = m.size()*sizeof(dcomplex);
+	if (header[2] == RAW) {
+		if (size > 0) std::memcpy(m.data(), &bytes[sizeof(header)], size);
+		return;
+	}
+
+	long numDoubles = 2*m.size();
+	std::vector<unsigned char> shuffled(std::max(size, 1L));
+	uLongf rawSize = size;
+	int status = uncompress(&shuffled[0], &rawSize,
+			                (const Bytef*) &bytes[sizeof(header)], bytes.size()-sizeof(header));
+	if (status != Z_OK || rawSize != size) {
+		std::cout << "Failed to decompress a block (zlib error " << status << ")" << std::endl;
+		exit(-1);
+	}
+	unsigned char* raw = (unsigned char*) m.data();
+	for (long i=0; i<numDoubles; ++i) {
+		for (int k=0; k<sizeof(double); ++k) {
+			raw[i*sizeof(double) + k] = shuffled[k*numDoubles + i];
+		}
+	}
+}
+
+
+SpillStore::SpillStore(std::string prefix, double tolerance, int maxPending)
+		: prefix(prefix), tolerance(tolerance), maxPending(std::max(maxPending, 1)),
+		  stopping(false), pendingWrites(0), written(0), stored(0) {
+	pthread_mutex_init(&mutex, NULL);
+	pthread_cond_init(&changed, NULL);
+	if (pthread_create(&thread, NULL, SpillStore::run, this) != 0) {
+		std::cout << "Failed to start the thread of the spill store" << std::endl;
+		exit(-1);
+	}
+}
+
+
+SpillStore::~SpillStore() {
+	pthread_mutex_lock(&mutex);
+	stopping = true;
+	pthread_cond_broadcast(&changed);
+	pthread_mutex_unlock(&mutex);
+	pthread_join(thread, NULL);
+
+	for (std::map<int, CDMatrix*>::iterator it=loaded.begin(); it!=loaded.end(); ++it) {
+		delete it->second;
+	}
+	for (std::set<int>::iterator it=onDisk.begin(); it!=onDisk.end(); ++it) {
+		remove(filename(*it).c_str());
+	}
+	pthread_cond_destroy(&changed);
+	pthread_mutex_destroy(&mutex);
+}
+
+
+std::string SpillStore::filename(int key) const {
+	return prefix + itos(key) + ".spill";
+}
+
+
+void SpillStore::store(int key, const Eigen::Ref<const CDMatrix>& m) {
+	SpillJob* job = new SpillJob;
+	job->write = true;
+	job->key = key;
+	allocateMatrix(job->matrix, m.rows(), m.cols());
+	job->matrix = m;
+	pthread_mutex_lock(&mutex);
+	while (pendingWrites >= maxPending) {
+		pthread_cond_wait(&changed, &mutex);
+	}
+	jobs.push_back(job);
+	pendingWrites++;
+	stored += m.size()*sizeof(dcomplex);
+	pthread_cond_broadcast(&changed);
+	pthread_mutex_unlock(&mutex);
+}
+
+
+void SpillStore::prefetch(int key) {
+	pthread_mutex_lock(&mutex);
+	if (requested.find(key) == requested.end()) {
+		requested.insert(key);
+		SpillJob* job = new SpillJob;
+		job->write = false;
+		job->key = key;
+		jobs.push_back(job);
+		pthread_cond_broadcast(&changed);
+	}
+	pthread_mutex_unlock(&mutex);
+}
+
+
+void SpillStore::load(int key, CDMatrix& m) {
+	prefetch(key);
+	pthread_mutex_lock(&mutex);
+	while (loaded.find(key) == loaded.end()) {
+		pthread_cond_wait(&changed, &mutex);
+	}
+	CDMatrix* block = loaded[key];
+	loaded.erase(key);
+	requested.erase(key);
+	pthread_mutex_unlock(&mutex);
+	m.swap(*block);
+	delete block;
+}
+
+
+long SpillStore::diskBytes() {
+	pthread_mutex_lock(&mutex);
+	long bytes = written;
+	pthread_mutex_unlock(&mutex);
+	return bytes;
+}
+
+
+long SpillStore::matrixBytes() {
+	pthread_mutex_lock(&mutex);
+	long bytes = stored;
+	pthread_mutex_unlock(&mutex);
+	return bytes;
+}
+
+
+void* SpillStore::run(void* store) {
+	((SpillStore*) store)->work();
+	return NULL;
+}
+
+
+/**
+ * the jobs in the order they were queued, so that a block is always read
+ * after it was written
+ */
+void SpillStore::work() {
+	pthread_mutex_lock(&mutex);
+	while (true) {
+		while (jobs.empty() && !stopping) {
+			pthread_cond_wait(&changed, &mutex);
+		}
+		if (jobs.empty()) break;
+		SpillJob* job = jobs.front();
+		jobs.pop_front();
+		pthread_mutex_unlock(&mutex);
+
+		int key = job->key;
+		std::string name = filename(key);
+		long bytesWritten = 0;
+		CDMatrix* block = NULL;
+		std::vector<char> bytes;
+		if (job->write) {
+			encodeBlock(job->matrix, tolerance, bytes);
+			std::ofstream f(name.c_str(), std::ios::binary);
+			f.write(&bytes[0], bytes.size());
+			f.close();
+			if (!f) {
+				std::cout << "Failed to write " << name << std::endl;
+				exit(-1);
+			}
+			bytesWritten = bytes.size();
+		} else {
+			std::ifstream f(name.c_str(), std::ios::binary);
+			if (!f) {
+				std::cout << "Failed to read " << name << std::endl;
+				exit(-1);
+			}
+			bytes.assign((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+			f.close();
+			remove(name.c_str());
+			block = new CDMatrix;
+			decodeBlock(bytes, *block);
+		}
+		delete job;
+
+		pthread_mutex_lock(&mutex);
+		if (block == NULL) {
+			pendingWrites--;
+			written += bytesWritten;
+			onDisk.insert(key);
+		} else {
+			loaded[key] = block;
+			onDisk.erase(key);
+		}
+		pthread_cond_broadcast(&changed);
+	}
+	pthread_mutex_unlock(&mutex);
+}
@@ -0,0 +1,108 @@
+/*
+ * spillStore.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Out-of-core storage of the A (ATilde) chain of calculateAllGreenFunc.
+ *
+ * saveMatrixBin/loadMatrixBin block the recursion while the file is written
+ * or read. A SpillStore hands the blocks to a background thread instead:
+ * store() returns as soon as the block is queued (it waits only if
+ * maxPending writes are already queued), and prefetch() starts reading a
+ * block so that load() finds it in memory while the caller was busy with
+ * the previous one.
+ *
+ * The blocks may be encoded before they are written:
+ *
+ *   tolerance < 0     raw, as saveMatrixBin
+ *   tolerance = 0     lossless: the bytes of the doubles are shuffled (all
+ *                     the first bytes, then all the second bytes, ...) so
+ *                     that the signs and exponents sit together, then deflated
+ *                     (level 1, run-length matching only)
+ *   tolerance > 0     the mantissas are rounded to the bits needed for a
+ *                     relative error below tolerance first; the dropped low
+ *                     bytes then become runs of zeros
+ *
+ * The files <prefix><key>.spill are removed when they are loaded, and the
+ * ones still left when the store is destroyed.
+ */
+
+#ifndef SPILLSTORE_H_
+#define SPILLSTORE_H_
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <pthread.h>
+#include "../Utility/types.h"
+
+
+/**
+ * the file content of m encoded with the given tolerance (see above)
+ */
+void encodeBlock(const CDMatrix& m, double tolerance, std::vector<char>& bytes);
+
+void decodeBlock(const std::vector<char>& bytes, CDMatrix& m);
+
+
+class SpillStore {
+public:
+	SpillStore(std::string prefix, double tolerance=-1.0, int maxPending=2);
+	~SpillStore();
+
+	/**
+	 * queue a copy of m to be written as block key
+	 */
+	void store(int key, const Eigen::Ref<const CDMatrix>& m);
+
+	/**
+	 * start reading block key (after the writes queued before)
+	 */
+	void prefetch(int key);
+
+	/**
+	 * block key, waiting for the read if needed; its file is removed
+	 */
+	void load(int key, CDMatrix& m);
+
+	/**
+	 * the bytes written to the disk and the bytes of the matrices stored
+	 */
+	long diskBytes();
+	long matrixBytes();
+
+private:
+	SpillStore(const SpillStore&);
+	SpillStore& operator=(const SpillStore&);
+
+	typedef struct {
+		bool write;
+		int key;
+		CDMatrix matrix;
+	} SpillJob;
+
+	std::string filename(int key) const;
+	static void* run(void* store);
+	void work();
+
+	std::string prefix;
+	double tolerance;
+	int maxPending;
+
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t changed;
+	bool stopping;
+	std::deque<SpillJob*> jobs;
+	int pendingWrites;
+	std::set<int> requested;            // reads queued or done
+	std::map<int, CDMatrix*> loaded;    // reads done
+	std::set<int> onDisk;
+	long written;
+	long stored;
+};
+
+#endif /* SPILLSTORE_H_ */
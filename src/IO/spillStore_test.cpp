@@ -0,0 +1,72 @@
+/*
+ * spillStore_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "spillStore.h"
+#include "../Utility/misc.h"
+#include <fstream>
+
+
+TEST(SpillStore, Codecs) {
+	CDMatrix m = CDMatrix::Random(40, 30);
+	m.col(3).setZero();
+	std::vector<char> raw, lossless, lossy;
+	CDMatrix decoded;
+
+	encodeBlock(m, -1.0, raw);
+	EXPECT_EQ(raw.size(), 4*sizeof(int) + m.size()*sizeof(dcomplex));
+	decodeBlock(raw, decoded);
+	EXPECT_TRUE(decoded == m);
+
+	encodeBlock(m, 0.0, lossless);
+	decodeBlock(lossless, decoded);
+	EXPECT_TRUE(decoded == m);
+
+	double tolerance = 1e-6;
+	encodeBlock(m, tolerance, lossy);
+	decodeBlock(lossy, decoded);
+	EXPECT_LT(lossy.size(), lossless.size()/2);
+	for (int j=0; j<m.cols(); ++j) {
+		for (int i=0; i<m.rows(); ++i) {
+			EXPECT_LE(std::abs(decoded(i, j).real()-m(i, j).real()), tolerance*std::abs(m(i, j).real()));
+			EXPECT_LE(std::abs(decoded(i, j).imag()-m(i, j).imag()), tolerance*std::abs(m(i, j).imag()));
+		}
+	}
+
+	CDMatrix empty;
+	encodeBlock(empty, 0.0, lossless);
+	decodeBlock(lossless, decoded);
+	EXPECT_EQ(decoded.size(), 0);
+}
+
+
+TEST(SpillStore, StoreAndLoad) {
+	std::vector<CDMatrix> blocks;
+	for (int k=0; k<5; ++k) {
+		blocks.push_back(CDMatrix::Random(20+k, 10));
+	}
+	{
+		SpillStore spill("spill_test_", 0.0, 1);
+		for (int k=0; k<5; ++k) {
+			spill.store(k, blocks[k]);
+		}
+		spill.prefetch(4);
+		for (int k=4; k>=1; --k) {
+			CDMatrix m;
+			spill.load(k, m);
+			if (k>1) spill.prefetch(k-1);
+			EXPECT_TRUE(m == blocks[k]);
+			std::ifstream f(("spill_test_" + itos(k) + ".spill").c_str());
+			EXPECT_FALSE(f.good());
+		}
+		EXPECT_EQ(spill.matrixBytes(), (20+21+22+23+24)*10*sizeof(dcomplex));
+		EXPECT_GT(spill.diskBytes(), 0);
+	}
+	// the block that was never loaded is removed with the store
+	std::ifstream f("spill_test_0.spill");
+	EXPECT_FALSE(f.good());
+}
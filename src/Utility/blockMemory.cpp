@@ -0,0 +1,138 @@
+/*
+ * blockMemory.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "blockMemory.h"
+#include "misc.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <stdint.h>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+
+static bool useHugePages = false;
+
+
+void setHugePages(bool on) {
+	useHugePages = on;
+}
+
+
+bool hugePages() {
+	return useHugePages;
+}
+
+
+bool adviseHugePages(void* data, long bytes) {
+#ifdef MADV_HUGEPAGE
+	const uintptr_t hugePage = 2*1024*1024;
+	uintptr_t first = ((uintptr_t) data + hugePage - 1) & ~(hugePage - 1);
+	uintptr_t last = ((uintptr_t) data + bytes) & ~(hugePage - 1);
+	if (last <= first) return false;
+	return madvise((void*) first, last - first, MADV_HUGEPAGE) == 0;
+#else
+	return false;
+#endif
+}
+
+
+void allocateMatrix(CDMatrix& m, int rows, int cols) {
+	if (m.rows() == rows && m.cols() == cols) return;
+	m.resize(rows, cols);
+	if (useHugePages) adviseHugePages(m.data(), m.size()*sizeof(dcomplex));
+}
+
+
+BlockBuffer::BlockBuffer() : buffer(NULL), size(0) {
+}
+
+
+BlockBuffer::~BlockBuffer() {
+	free(buffer);
+}
+
+
+void BlockBuffer::reserve(long elements) {
+	if (elements <= size) return;
+	free(buffer);
+	buffer = NULL;
+	size = 0;
+	// whole 2MB pages from a 2MB boundary, so that madvise covers all of it
+	const long hugePage = 2L*1024*1024;
+	long bytes = elements*sizeof(dcomplex);
+	long alignment = 64;
+	if (bytes >= hugePage) {
+		alignment = hugePage;
+		bytes = (bytes + hugePage - 1)/hugePage*hugePage;
+	}
+	void* data;
+	if (posix_memalign(&data, alignment, bytes) != 0) {
+		std::cout << "Cannot allocate " << bytes << " bytes for the blocks" << std::endl;
+		exit(-1);
+	}
+	if (useHugePages) adviseHugePages(data, bytes);
+	buffer = (dcomplex*) data;
+	size = bytes/sizeof(dcomplex);
+}
+
+
+CDMatrixMap BlockBuffer::block(int rows, int cols) {
+	return CDMatrixMap(buffer, rows, cols);
+}
+
+
+void BlockBuffer::swap(BlockBuffer& other) {
+	std::swap(buffer, other.buffer);
+	std::swap(size, other.size);
+}
+
+
+int numaNodes() {
+	DIR* dir = opendir("/sys/devices/system/node");
+	if (dir == NULL) return 1;
+	int nodes = 0;
+	struct dirent* entry;
+	while ((entry = readdir(dir)) != NULL) {
+		int node;
+		char rest;
+		if (sscanf(entry->d_name, "node%d%c", &node, &rest) == 1) nodes++;
+	}
+	closedir(dir);
+	return max(nodes, 1);
+}
+
+
+/**
+ * the CPUs of a node are listed as ranges, e.g. "0-7,16-23"
+ */
+bool pinToNode(int node) {
+	std::ifstream f(("/sys/devices/system/node/node" + itos(node) + "/cpulist").c_str());
+	std::string list;
+	if (node < 0 || !std::getline(f, list)) return false;
+
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	int count = 0;
+	std::stringstream ranges(list);
+	std::string range;
+	while (std::getline(ranges, range, ',')) {
+		int first, last;
+		int fields = sscanf(range.c_str(), "%d-%d", &first, &last);
+		if (fields < 1) continue;
+		if (fields == 1) last = first;
+		for (int cpu=first; cpu<=last && cpu<CPU_SETSIZE; ++cpu) {
+			CPU_SET(cpu, &cpus);
+			count++;
+		}
+	}
+	if (count == 0) return false;
+	return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+}
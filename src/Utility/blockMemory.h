@@ -0,0 +1,95 @@
+/*
+ * blockMemory.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Placement of the large block matrices of the recursion.
+ *
+ * The recursion forms its blocks in BlockBuffers that it allocates once per
+ * sweep, and the blocks that outlive a step (the A_K handed to the caller or
+ * to a SpillStore) are allocated with allocateMatrix:
+ *
+ *   setHugePages(true)     the buffers and matrices are marked for transparent
+ *                          huge pages (MADV_HUGEPAGE) before they are first
+ *                          touched. A BlockBuffer is aligned to 2MB and rounded
+ *                          up to whole 2MB pages, so all of it gets huge pages;
+ *                          a matrix from malloc gets them on the 2MB pages
+ *                          inside it. (Every other allocation can be put on
+ *                          huge pages by glibc >= 2.35 with the environment
+ *                          GLIBC_TUNABLES=glibc.malloc.hugetlb=1, or =2 for
+ *                          hugetlbfs pages reserved by the administrator.)
+ *   pinToNode(node)        binds the process to the CPUs of a NUMA node. Linux
+ *                          puts a page on the node of the CPU that touches it
+ *                          first, so everything a pinned worker allocates and
+ *                          fills (its A chain and its buffers) is local.
+ */
+
+#ifndef BLOCKMEMORY_H_
+#define BLOCKMEMORY_H_
+
+#include "types.h"
+
+
+void setHugePages(bool on);
+
+bool hugePages();
+
+/**
+ * advise the whole 2MB pages inside [data, data+bytes) for transparent huge
+ * pages; false if there is none or the kernel refuses
+ */
+bool adviseHugePages(void* data, long bytes);
+
+/**
+ * resize m to rows x cols and advise it for huge pages if they are on; the
+ * content is unspecified
+ */
+void allocateMatrix(CDMatrix& m, int rows, int cols);
+
+
+/**
+ * storage for the blocks that a loop forms again at every step
+ */
+class BlockBuffer {
+public:
+	BlockBuffer();
+	~BlockBuffer();
+
+	/**
+	 * room for size elements (the content is lost if it has to grow)
+	 */
+	void reserve(long size);
+
+	/**
+	 * rows x cols in the leading part of the buffer
+	 */
+	CDMatrixMap block(int rows, int cols);
+
+	void swap(BlockBuffer& other);
+
+	dcomplex* data() { return buffer; }
+
+	long capacity() const { return size; }
+
+private:
+	// a buffer has a single owner
+	BlockBuffer(const BlockBuffer&);
+	BlockBuffer& operator=(const BlockBuffer&);
+
+	dcomplex* buffer;
+	long size;
+};
+
+/**
+ * the number of NUMA nodes (1 if the system doesn't tell)
+ */
+int numaNodes();
+
+/**
+ * bind the calling thread, and the threads it creates afterwards, to the CPUs
+ * of the node; false if the node doesn't exist
+ */
+bool pinToNode(int node);
+
+#endif /* BLOCKMEMORY_H_ */
@@ -0,0 +1,74 @@
+/*
+ * blockMemory_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "blockMemory.h"
+#include <sched.h>
+#include <stdint.h>
+
+
+TEST(BlockMemory, AllocateMatrix) {
+	// no whole 2MB page inside a small block
+	CDMatrix small(10, 10);
+	EXPECT_FALSE(adviseHugePages(small.data(), small.size()*sizeof(dcomplex)));
+
+	setHugePages(true);
+	EXPECT_TRUE(hugePages());
+	CDMatrix m;
+	allocateMatrix(m, 1024, 512);
+	setHugePages(false);
+	EXPECT_EQ(m.rows(), 1024);
+	EXPECT_EQ(m.cols(), 512);
+}
+
+
+TEST(BlockMemory, BlockBuffer) {
+	const long hugePage = 2L*1024*1024;
+	setHugePages(true);
+	BlockBuffer buffer;
+	buffer.reserve(400*400);
+	setHugePages(false);
+	// aligned to 2MB and rounded up to whole 2MB pages
+	EXPECT_EQ((uintptr_t) buffer.data() % hugePage, 0);
+	EXPECT_EQ(buffer.capacity()*sizeof(dcomplex) % hugePage, 0);
+	EXPECT_GE(buffer.capacity(), 400*400);
+	EXPECT_TRUE(adviseHugePages(buffer.data(), buffer.capacity()*sizeof(dcomplex)));
+
+	// a smaller request keeps the storage
+	dcomplex* data = buffer.data();
+	buffer.reserve(10);
+	EXPECT_EQ(buffer.data(), data);
+
+	CDMatrixMap block = buffer.block(200, 300);
+	block.setIdentity();
+	EXPECT_EQ(block.data(), data);
+	EXPECT_EQ(block.rows(), 200);
+	EXPECT_EQ(block.cols(), 300);
+
+	BlockBuffer other;
+	other.reserve(10);
+	buffer.swap(other);
+	EXPECT_EQ(other.data(), data);
+	EXPECT_EQ(other.block(200, 300).trace(), dcomplex(200.0, 0.0));
+}
+
+
+TEST(BlockMemory, PinToNode) {
+	cpu_set_t before;
+	sched_getaffinity(0, sizeof(before), &before);
+
+	EXPECT_GE(numaNodes(), 1);
+	EXPECT_FALSE(pinToNode(-1));
+	EXPECT_FALSE(pinToNode(numaNodes()+1000));
+	if (pinToNode(0)) {
+		cpu_set_t pinned;
+		sched_getaffinity(0, sizeof(pinned), &pinned);
+		EXPECT_GT(CPU_COUNT(&pinned), 0);
+	}
+
+	sched_setaffinity(0, sizeof(before), &before);
+}
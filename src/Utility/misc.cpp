@@ -5,6 +5,8 @@
  *      Author: pxiang
  */
 #include "misc.h"
+#include <sys/time.h>
+#include <sys/resource.h>
 
 
 std::string itos(int n) {
@@ -126,3 +128,17 @@ std::vector<double> linspace(double start, double stop, int num) {
 }
 
 
+// wall-clock time in seconds
+double wallTime() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + 1.e-6*tv.tv_usec;
+}
+
+
+// the peak resident set size of the process in kB (ru_maxrss is in kB on Linux)
+long peakResidentMemory() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
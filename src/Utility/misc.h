@@ -49,6 +49,12 @@ void read_double_column(std::string filename, int column, std::vector<double>& a
 
 std::vector<double> linspace(double start, double stop, int num=100);
 
+// wall-clock time in seconds
+double wallTime();
+
+// the peak resident memory of the process in kB (it never decreases)
+long peakResidentMemory();
+
 
 
 
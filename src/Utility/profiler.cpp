@@ -0,0 +1,191 @@
+/*
+ * profiler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#include "profiler.h"
+#include "misc.h"
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+Profiler profiler;
+
+
+Profiler::Profiler() {
+	traceEnabled = true;
+	origin = wallTime();
+}
+
+
+void Profiler::clear() {
+	origin = wallTime();
+	stats.clear();
+	events.clear();
+	blockSizes.clear();
+	blockSeconds.clear();
+}
+
+
+double Profiler::now() const {
+	return wallTime();
+}
+
+
+/**
+ * accumulate one timed call; the events may come from several OpenMP
+ * threads, so the containers are only touched inside a critical section
+ */
+void Profiler::record(const char* name, int K, double start, double stop) {
+	int thread = 0;
+#ifdef _OPENMP
+	thread = omp_get_thread_num();
+#endif
+	double duration = stop - start;
+#pragma omp critical(profiler)
+	{
+		ProfileStat& stat = stats[name];
+		stat.count += 1;
+		stat.seconds += duration;
+		stat.maxSeconds = std::max(stat.maxSeconds, duration);
+
+		if (K >= 0) {
+			blockSeconds[name][K] += duration;
+		}
+
+		if (traceEnabled) {
+			ProfileEvent event;
+			event.name = name;
+			event.thread = thread;
+			event.start = start - origin;
+			event.duration = duration;
+			event.K = K;
+			events.push_back(event);
+		}
+	}
+}
+
+
+void Profiler::addBytes(const char* name, double bytes) {
+#pragma omp critical(profiler)
+	{
+		stats[name].bytes += bytes;
+	}
+}
+
+
+void Profiler::addMatrix(const char* name, int K, int rows, int cols) {
+	ProfileBlockSize size;
+	size.rows = rows;
+	size.cols = cols;
+#pragma omp critical(profiler)
+	{
+		blockSizes[name][K] = size;
+	}
+}
+
+
+void Profiler::printSummary(std::ostream& out) const {
+	out << "---------------------------- profile ----------------------------\n";
+	out << std::setw(24) << std::left << "phase" << std::right
+		<< std::setw(10) << "calls"
+		<< std::setw(14) << "total (s)"
+		<< std::setw(14) << "max (s)"
+		<< std::setw(14) << "MB" << "\n";
+	std::map<std::string, ProfileStat>::const_iterator it;
+	for (it=stats.begin(); it!=stats.end(); ++it) {
+		const ProfileStat& stat = it->second;
+		out << std::setw(24) << std::left << it->first << std::right
+			<< std::setw(10) << stat.count
+			<< std::setw(14) << stat.seconds
+			<< std::setw(14) << stat.maxSeconds
+			<< std::setw(14) << stat.bytes/(1024.0*1024.0) << "\n";
+	}
+	out << "peak resident memory: " << peakResidentMemory() << " kB\n";
+
+	/*
+	 * the dense solve of a block is O(n^3), so time/n^3 should be roughly
+	 * the same for every K; print it relative to the median of the step
+	 */
+	std::map<std::string, std::map<int, double> >::const_iterator step;
+	for (step=blockSeconds.begin(); step!=blockSeconds.end(); ++step) {
+		// the block size of a step is the size of W at the same K
+		std::map<std::string, std::map<int, ProfileBlockSize> >::const_iterator
+			sizes = blockSizes.find("W");
+		if (sizes == blockSizes.end()) break;
+
+		std::vector<int> Ks;
+		std::vector<double> perFlop;
+		std::map<int, double>::const_iterator k;
+		for (k=step->second.begin(); k!=step->second.end(); ++k) {
+			std::map<int, ProfileBlockSize>::const_iterator size =
+					sizes->second.find(k->first);
+			if (size == sizes->second.end() || size->second.rows == 0) continue;
+			double n = size->second.rows;
+			Ks.push_back(k->first);
+			perFlop.push_back(k->second/(n*n*n));
+		}
+		if (perFlop.empty()) continue;
+
+		std::vector<double> sorted = perFlop;
+		std::sort(sorted.begin(), sorted.end());
+		double median = sorted[sorted.size()/2];
+
+		out << step->first << " per block:\n";
+		out << std::setw(10) << "K" << std::setw(10) << "n"
+			<< std::setw(14) << "time (s)" << std::setw(14) << "rel. t/n^3" << "\n";
+		for (int i=0; i<Ks.size(); ++i) {
+			int n = sizes->second.find(Ks[i])->second.rows;
+			out << std::setw(10) << Ks[i] << std::setw(10) << n
+				<< std::setw(14) << step->second.find(Ks[i])->second
+				<< std::setw(14) << (median > 0 ? perFlop[i]/median : 0.0) << "\n";
+		}
+	}
+	out << "-----------------------------------------------------------------\n";
+}
+
+
+/**
+ * write the events in the Chrome trace-event format (times in microseconds)
+ */
+void Profiler::saveTrace(std::string filename) const {
+	if (!traceEnabled) return;
+	std::ofstream out(filename.c_str());
+	if (!out) {
+		std::cout << "Cannot open " << filename << " for the trace" << std::endl;
+		return;
+	}
+	out << std::setprecision(15);
+	out << "{\"traceEvents\": [\n";
+	for (int i=0; i<events.size(); ++i) {
+		const ProfileEvent& event = events[i];
+		out << "{\"name\": \"" << event.name << "\", \"ph\": \"X\""
+			<< ", \"pid\": 0, \"tid\": " << event.thread
+			<< ", \"ts\": " << 1.e6*event.start
+			<< ", \"dur\": " << 1.e6*event.duration;
+		if (event.K >= 0) {
+			out << ", \"args\": {\"K\": " << event.K << "}";
+		}
+		out << "}" << (i+1<events.size() ? ",\n" : "\n");
+	}
+	out << "]}\n";
+	out.close();
+}
+
+
+ScopedTimer::ScopedTimer(const char* name, int K) {
+	this->name = name;
+	this->K = K;
+	start = profiler.now();
+}
+
+
+ScopedTimer::~ScopedTimer() {
+	profiler.record(name, K, start, profiler.now());
+}
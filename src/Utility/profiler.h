@@ -0,0 +1,129 @@
+/*
+ * profiler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ *
+ * Scoped timers and counters for the hot paths of the recursion.
+ *
+ * All the macros below expand to nothing unless the code is compiled with
+ * -DPROFILING, so a normal build pays nothing for the instrumentation:
+ *
+ *   PROFILE_SCOPE("solve");          // time the rest of the enclosing scope
+ *   PROFILE_SCOPE_K("rightStep", K); // same, tagged with the block index K
+ *   PROFILE_BYTES("store", bytes);   // count bytes moved by a phase
+ *   PROFILE_MATRIX("W", K, WK);      // record the size of a block matrix
+ *   PROFILE_REPORT("trace.json");    // print the summary, write the timeline
+ *
+ * The timeline is written in the Chrome trace-event format (open it with
+ * chrome://tracing or https://ui.perfetto.dev), one row per OpenMP thread.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+
+
+typedef struct {
+	int count;
+	double seconds; // total time spent in the phase
+	double maxSeconds; // the slowest single call
+	double bytes; // bytes counted with PROFILE_BYTES
+} ProfileStat;
+
+
+typedef struct {
+	std::string name;
+	int thread;
+	double start; // in seconds, relative to the first profiled event
+	double duration;
+	int K; // -1 if the event is not tied to a block
+} ProfileEvent;
+
+
+typedef struct {
+	int rows;
+	int cols;
+} ProfileBlockSize;
+
+
+class Profiler {
+public:
+	Profiler();
+
+	void clear();
+
+	// keep every event for the timeline (on by default; turn it off for long
+	// runs since the summary only needs the accumulated totals)
+	void enableTrace(bool flag) { traceEnabled = flag; }
+
+	double now() const;
+	void record(const char* name, int K, double start, double stop);
+	void addBytes(const char* name, double bytes);
+	void addMatrix(const char* name, int K, int rows, int cols);
+
+	const std::map<std::string, ProfileStat>& getStats() const { return stats; }
+	const std::vector<ProfileEvent>& getEvents() const { return events; }
+
+	/**
+	 * the totals per phase, the peak resident memory and, for the steps
+	 * tagged with K, the time per block normalized by n^3 (n = rows of the
+	 * block) so that a block that is slower than its size suggests stands out
+	 */
+	void printSummary(std::ostream& out) const;
+
+	void saveTrace(std::string filename) const;
+
+private:
+	bool traceEnabled;
+	double origin;
+	std::map<std::string, ProfileStat> stats;
+	std::vector<ProfileEvent> events;
+	// block sizes per matrix name and K
+	std::map<std::string, std::map<int, ProfileBlockSize> > blockSizes;
+	// accumulated time per step name and K
+	std::map<std::string, std::map<int, double> > blockSeconds;
+};
+
+// the profiler shared by all the instrumented code
+extern Profiler profiler;
+
+
+/**
+ * time the lifetime of the object and hand it to the profiler
+ */
+class ScopedTimer {
+public:
+	ScopedTimer(const char* name, int K=-1);
+	~ScopedTimer();
+private:
+	const char* name;
+	int K;
+	double start;
+};
+
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef PROFILING
+#define PROFILE_SCOPE(name) ScopedTimer PROFILE_CONCAT(scopedTimer_, __LINE__)(name)
+#define PROFILE_SCOPE_K(name, K) ScopedTimer PROFILE_CONCAT(scopedTimer_, __LINE__)(name, K)
+#define PROFILE_BYTES(name, bytes) profiler.addBytes(name, bytes)
+#define PROFILE_MATRIX(name, K, m) profiler.addMatrix(name, K, (m).rows(), (m).cols())
+#define PROFILE_REPORT(traceFile) \
+	do { profiler.printSummary(std::cout); profiler.saveTrace(traceFile); } while (0)
+#else
+#define PROFILE_SCOPE(name) ((void) 0)
+#define PROFILE_SCOPE_K(name, K) ((void) 0)
+#define PROFILE_BYTES(name, bytes) ((void) 0)
+#define PROFILE_MATRIX(name, K, m) ((void) 0)
+#define PROFILE_REPORT(traceFile) ((void) 0)
+#endif
+
+
+#endif /* PROFILER_H_ */
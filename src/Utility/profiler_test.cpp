@@ -0,0 +1,60 @@
+/*
+ * profiler_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "profiler.h"
+#include "misc.h"
+#include <sstream>
+#include <fstream>
+
+
+TEST(ProfilerTest, Accumulate) {
+	Profiler prof;
+	double t0 = prof.now();
+	prof.record("solve", 5, t0, t0+0.5);
+	prof.record("solve", 9, t0+0.5, t0+0.75);
+	prof.addBytes("store", 1024.0);
+	prof.addBytes("store", 2048.0);
+
+	const std::map<std::string, ProfileStat>& stats = prof.getStats();
+	ASSERT_EQ(stats.count("solve"), 1);
+	EXPECT_EQ(stats.find("solve")->second.count, 2);
+	EXPECT_NEAR(stats.find("solve")->second.seconds, 0.75, 1e-12);
+	EXPECT_NEAR(stats.find("solve")->second.maxSeconds, 0.5, 1e-12);
+	EXPECT_DOUBLE_EQ(stats.find("store")->second.bytes, 3072.0);
+	EXPECT_EQ(prof.getEvents().size(), 2);
+	EXPECT_EQ(prof.getEvents()[1].K, 9);
+
+	prof.clear();
+	EXPECT_TRUE(prof.getStats().empty());
+	EXPECT_TRUE(prof.getEvents().empty());
+}
+
+
+TEST(ProfilerTest, SummaryAndTrace) {
+	Profiler prof;
+	double t0 = prof.now();
+	// two blocks of different sizes that take the same time per n^3
+	prof.addMatrix("W", 1, 10, 10);
+	prof.addMatrix("W", 5, 20, 20);
+	prof.record("rightStep", 1, t0, t0+1.0);
+	prof.record("rightStep", 5, t0+1.0, t0+9.0);
+
+	std::ostringstream summary;
+	prof.printSummary(summary);
+	EXPECT_NE(summary.str().find("rightStep per block"), std::string::npos);
+	EXPECT_NE(summary.str().find("peak resident memory"), std::string::npos);
+
+	prof.saveTrace("profiler_test.json");
+	std::ifstream in("profiler_test.json");
+	std::string content((std::istreambuf_iterator<char>(in)),
+			std::istreambuf_iterator<char>());
+	in.close();
+	EXPECT_EQ(content.find("{\"traceEvents\": ["), 0);
+	EXPECT_NE(content.find("\"args\": {\"K\": 5}"), std::string::npos);
+	remove("profiler_test.json");
+}
@@ -24,10 +24,12 @@
 
 
 typedef std::complex<double> dcomplex;
+typedef std::complex<float> fcomplex;
 
 // use eigen c++ library
 #define EIGEN_USE_MKL_ALL
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 
 /**
  * matrix, vector and array class from eigen lib
@@ -44,6 +46,25 @@ typedef Eigen::VectorXd DVector;
 typedef Eigen::ArrayXd DArray;
 typedef Eigen::ArrayXcd CDArray;
 
+/**
+ * a matrix in storage owned by someone else (the buffers that the recursion
+ * reuses from one block to the next)
+ */
+typedef Eigen::Map<CDMatrix> CDMatrixMap;
+
+/**
+ * single precision, for the mixed-precision recursion
+ */
+typedef Eigen::MatrixXcf CFMatrix;
+
+/**
+ * sparse matrices (column-major) used by the engines that work on the full
+ * two-particle Hamiltonian without forming it as a dense matrix
+ */
+typedef Eigen::SparseMatrix<double> DSparseMatrix;
+typedef Eigen::SparseMatrix<dcomplex> CDSparseMatrix;
+typedef Eigen::Triplet<double> DTriplet;
+
 
 
 #include <list>
@@ -153,6 +153,13 @@ std::vector<int> DimsOfV;
  *                                corresponding vector V_{x1+y1+x2+y2}
  */
 IMatrix IndexMatrix;
+
+
+/**
+ * MaxRelativeDistance limits the basis to the pairs with x2 - x1 <=
+ * MaxRelativeDistance (0 means no limit); it is set by generateIndexMatrix
+ */
+int MaxRelativeDistance = 0;
 /***********************************************************************/
 
 
@@ -266,6 +273,7 @@ void generateIndexMatrix(LatticeShape& lattice) {
 	VtoG.clear();
 	DimsOfV.clear();
 	IndexMatrix.resize(0,0);
+	MaxRelativeDistance = 0;
 
 	int dim = lattice.getDim();
 	switch (dim) {
@@ -346,7 +354,49 @@ void generateIndexMatrix(LatticeShape& lattice) {
 
 
 
+/**
+ * Generate VtoG and DimsOfV for the pairs with x2 - x1 <= maxRelativeDistance
+ *
+ * The pairs of V_K are still ordered by site1, so G(site1, site2) is the
+ * (site1 - VtoG[K][0][0])th element of V_K and IndexMatrix is not needed.
+ * maxRelativeDistance must be at least 2, otherwise V_K is empty for even K.
+ */
+void generateIndexMatrix(LatticeShape& lattice, int maxRelativeDistance) {
+	if (lattice.getDim()!=1) {
+		std::cout<<"Dimensions not supported!"<<std::endl;
+		exit(-1);
+	}
+	if (maxRelativeDistance < 2) {
+		std::cout << "The largest relative distance must be >= 2" << std::endl;
+		exit(-1);
+	}
+	VtoG.clear();
+	DimsOfV.clear();
+	IndexMatrix.resize(0,0);
+	MaxRelativeDistance = maxRelativeDistance;
+
+	int xmax = lattice.getXmax();
+	int Kmin = 1;
+	int Kmax = xmax + xmax - 1;
+	VtoG.resize(Kmax+1);
+	DimsOfV.assign(Kmax+1, 0);
+	for (int K = Kmin; K <= Kmax; ++K) {
+		// site2 - site1 = K - 2*site1 <= maxRelativeDistance and site2 <= xmax
+		int first = max(max(0, K-xmax), (K-maxRelativeDistance+1)/2);
+		for (int site1=first; site1<=(K-1)/2; ++site1) {
+			VtoG[K].push_back(Basis(site1, K-site1));
+		}
+		DimsOfV[K] = VtoG[K].size();
+	}
+}
 
 
-
-
+int getIndexInV(int site1, int site2) {
+	if (MaxRelativeDistance==0) {
+		return IndexMatrix(site1, site2);
+	}
+	if (site2-site1 > MaxRelativeDistance) {
+		return -1;
+	}
+	return site1 - VtoG[site1+site2][0][0];
+}
@@ -158,6 +158,9 @@ extern std::vector< std::vector< Basis > > VtoG;
 extern std::vector<int> DimsOfV;
 
 extern IMatrix IndexMatrix;
+
+// 0: all the pairs are in the basis; otherwise only x2 - x1 <= MaxRelativeDistance
+extern int MaxRelativeDistance;
 /********************************************************************/
 
 double distance(Basis& b1, Basis& b2);
@@ -268,6 +271,24 @@ void generateNeighbors(Basis basis, int distance, LatticeShape& lattice,
 
 void generateIndexMatrix(LatticeShape& lattice);
 
+/**
+ * the basis of the bound pairs: only x2 - x1 <= maxRelativeDistance, so
+ * every V_K has at most (maxRelativeDistance+1)/2 elements whatever xmax is
+ * (x2 - x1 has the parity of K) (1D only)
+ *
+ * IndexMatrix is not formed (it would need (xmax+1)^2 integers); use
+ * getIndexInV instead. Only the basis is truncated: the Interaction built by
+ * setLatticeAndInteractions still stores t and d as dense (xmax+1)^2
+ * matrices, which limits xmax to what those two matrices fit in.
+ */
+void generateIndexMatrix(LatticeShape& lattice, int maxRelativeDistance);
+
+/**
+ * G(site1, site2) is the nth element of V_{site1+site2} (site1 < site2);
+ * return -1 if the pair is not in the basis
+ */
+int getIndexInV(int site1, int site2);
+
 
 
 
@@ -240,6 +240,45 @@ TEST(GenerateIndexMatrixTest, Sites121) {
 	EXPECT_EQ(i,61);
 }
 
+TEST(GenerateIndexMatrixTest, TruncatedRelativeDistance) {
+	int xmax = 120;
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(xmax);
+	int rMax = 6;
+	generateIndexMatrix(lattice1D, rMax);
+
+	int total = 0;
+	for (int K=1; K<=2*xmax-1; ++K) {
+		EXPECT_GE(DimsOfV[K], 1);
+		EXPECT_LE(DimsOfV[K], (rMax+1)/2);
+		for (int nth=0; nth<DimsOfV[K]; ++nth) {
+			Basis basis = VtoG[K][nth];
+			EXPECT_EQ(basis.getSum(), K);
+			EXPECT_LE(basis[1]-basis[0], rMax);
+			EXPECT_EQ(getIndexInV(basis[0], basis[1]), nth);
+		}
+		total += DimsOfV[K];
+	}
+	// the pairs with 1 <= x2 - x1 <= rMax
+	int expected = 0;
+	for (int r=1; r<=rMax; ++r) expected += xmax+1-r;
+	EXPECT_EQ(total, expected);
+	EXPECT_EQ(getIndexInV(10, 10+rMax+1), -1);
+	// away from the edges the bound is reached for both parities of K
+	EXPECT_EQ(DimsOfV[xmax], (rMax+1)/2);
+	EXPECT_EQ(DimsOfV[xmax+1], (rMax+1)/2);
+
+	// an odd cutoff: x2 - x1 = 1, 3, 5, 7 for odd K, but only 2, 4, 6 for even K
+	generateIndexMatrix(lattice1D, 7);
+	EXPECT_EQ(DimsOfV[xmax+1], 4);
+	EXPECT_EQ(DimsOfV[xmax], 3);
+
+	// the full basis again
+	generateIndexMatrix(lattice1D);
+	EXPECT_EQ(getIndexInV(10, 30), IndexMatrix(10, 30));
+	EXPECT_EQ(DimsOfV[121], 60);
+}
+
 TEST(GetLatticeIndex, TestPointerArgument) {
 	int xmax = 99;
 	LatticeShape lattice1D(1);
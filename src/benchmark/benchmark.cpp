@@ -0,0 +1,153 @@
+/*
+ * benchmark.cpp
+ *
+ *  Created on: Oct 21, 2026
+ *      Author: pxiang
+ */
+
+#include "benchmark.h"
+
+
+/**
+ * the p-th percentile of the samples (linear interpolation between ranks)
+ */
+double percentile(std::vector<double> samples, double p) {
+	if (samples.empty()) {
+		return 0.0;
+	}
+	std::sort(samples.begin(), samples.end());
+	double rank = p/100.0*(samples.size()-1);
+	int lower = int(rank);
+	int upper = min(lower+1, int(samples.size())-1);
+	double fraction = rank - lower;
+	return samples[lower] + fraction*(samples[upper] - samples[lower]);
+}
+
+
+std::string benchmarkKey(BenchmarkCase& benchmarkCase) {
+	return benchmarkCase.name + "/xmax=" + itos(benchmarkCase.xmax)
+	       + "/maxDistance=" + itos(benchmarkCase.maxDistance)
+	       + "/threads=" + itos(benchmarkCase.threads);
+}
+
+
+/**
+ * save the results in JSON format (one case per line)
+ *
+ * {
+ *   "cases": [
+ *     {"key": "...", "name": "...", "xmax": 101, ..., "median_s": 0.1, ...},
+ *     ...
+ *   ]
+ * }
+ */
+void writeBenchmarkJSON(std::string filename, std::vector<BenchmarkCase>& cases) {
+	std::ofstream out(filename.c_str());
+	out.precision(6);
+	out << "{" << std::endl;
+	out << "  \"cases\": [" << std::endl;
+	for (int i=0; i<cases.size(); ++i) {
+		BenchmarkCase& c = cases[i];
+		double median = percentile(c.samples, 50.0);
+		out << "    {\"key\": \"" << benchmarkKey(c) << "\""
+		    << ", \"name\": \"" << c.name << "\""
+		    << ", \"xmax\": " << c.xmax
+		    << ", \"maxDistance\": " << c.maxDistance
+		    << ", \"threads\": " << c.threads
+		    << ", \"repetitions\": " << c.samples.size()
+		    << ", \"median_s\": " << median
+		    << ", \"p10_s\": " << percentile(c.samples, 10.0)
+		    << ", \"p90_s\": " << percentile(c.samples, 90.0)
+		    << ", \"min_s\": " << percentile(c.samples, 0.0)
+		    << ", \"max_s\": " << percentile(c.samples, 100.0);
+		if (c.flops>0.0 && median>0.0) {
+			out << ", \"gflops\": " << c.flops/median/1.e9;
+		} else {
+			out << ", \"gflops\": null";
+		}
+		if (c.bytes>0.0 && median>0.0) {
+			out << ", \"gbytes_per_s\": " << c.bytes/median/1.e9;
+		} else {
+			out << ", \"gbytes_per_s\": null";
+		}
+		out << ", \"peak_rss_mb\": " << c.peakRSS/1024.0 << "}";
+		if (i!=cases.size()-1) {
+			out << ",";
+		}
+		out << std::endl;
+	}
+	out << "  ]" << std::endl;
+	out << "}" << std::endl;
+	out.close();
+}
+
+
+/**
+ * find the value of a field in a line written by writeBenchmarkJSON
+ */
+static std::string jsonField(std::string& line, std::string field) {
+	std::string pattern = "\"" + field + "\": ";
+	size_t start = line.find(pattern);
+	if (start==std::string::npos) {
+		return "";
+	}
+	start += pattern.size();
+	size_t end = line.find_first_of(",}", start);
+	std::string value = line.substr(start, end-start);
+	// remove the quotes around a string
+	if (!value.empty() && value[0]=='"') {
+		value = value.substr(1, value.size()-2);
+	}
+	return value;
+}
+
+
+/**
+ * read the median timings of a previous run
+ */
+void readBenchmarkBaseline(std::string filename, std::map<std::string, double>& medians) {
+	medians.clear();
+	std::ifstream in(filename.c_str());
+	if (!in) {
+		std::cout << "Can't open the baseline file " << filename << std::endl;
+		return;
+	}
+	std::string line;
+	while (getline(in, line)) {
+		std::string key = jsonField(line, "key");
+		std::string median = jsonField(line, "median_s");
+		if (!key.empty() && !median.empty()) {
+			medians[key] = atof(median.c_str());
+		}
+	}
+	in.close();
+}
+
+
+/**
+ * compare the median of each case with the baseline
+ */
+int compareWithBaseline(std::vector<BenchmarkCase>& cases,
+		                std::map<std::string, double>& medians, double tolerance) {
+	int regressions = 0;
+	for (int i=0; i<cases.size(); ++i) {
+		std::string key = benchmarkKey(cases[i]);
+		if (medians.find(key)==medians.end()) {
+			std::cout << "NEW         " << key << std::endl;
+			continue;
+		}
+		double baseline = medians[key];
+		double median = percentile(cases[i].samples, 50.0);
+		double ratio = (baseline>0.0)?median/baseline:1.0;
+		std::string status = "OK          ";
+		if (ratio>1.0+tolerance) {
+			status = "REGRESSION  ";
+			regressions++;
+		} else if (ratio<1.0-tolerance) {
+			status = "IMPROVEMENT ";
+		}
+		std::cout << status << key << "  " << median << " s vs "
+				  << baseline << " s (x" << ratio << ")" << std::endl;
+	}
+	return regressions;
+}
@@ -0,0 +1,79 @@
+/*
+ * benchmark.h
+ *
+ *  Created on: Oct 21, 2026
+ *      Author: pxiang
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include "../Utility/misc.h"
+
+/**
+ * The timings of one benchmark case
+ *
+ * name --- the name of the benchmarked function
+ * xmax, maxDistance, threads --- the point of the parameter grid
+ * samples --- the wall-clock time (in seconds) of each repetition
+ * flops --- the number of floating point operations of one repetition
+ *           (0 if it is not meaningful, e.g. for I/O)
+ * bytes --- the number of bytes moved by one repetition (0 if not meaningful)
+ * peakRSS --- the peak resident memory of the process (in kB) after the case
+ */
+typedef struct {
+	std::string name;
+	int xmax;
+	int maxDistance;
+	int threads;
+	std::vector<double> samples;
+	double flops;
+	double bytes;
+	long peakRSS;
+} BenchmarkCase;
+
+/**
+ * the p-th percentile (0 <= p <= 100) of the samples, with linear
+ * interpolation between the closest ranks
+ */
+double percentile(std::vector<double> samples, double p);
+
+/**
+ * the key that identifies a case in the baseline, e.g.
+ * solveDenseLinearEqs/xmax=101/maxDistance=4/threads=2
+ */
+std::string benchmarkKey(BenchmarkCase& benchmarkCase);
+
+/**
+ * save the results in JSON format
+ *
+ * Every case is written on its own line, so that the file can be read back
+ * with readBenchmarkBaseline and compared with another run.
+ */
+void writeBenchmarkJSON(std::string filename, std::vector<BenchmarkCase>& cases);
+
+/**
+ * read the median timings of a previous run (the baseline), written by
+ * writeBenchmarkJSON
+ *
+ * medians[key] = median time in seconds
+ */
+void readBenchmarkBaseline(std::string filename, std::map<std::string, double>& medians);
+
+/**
+ * compare the median of each case with the baseline and print a report
+ *
+ * A case is a regression if median > (1 + tolerance)*baseline_median.
+ * The number of regressions is returned.
+ */
+int compareWithBaseline(std::vector<BenchmarkCase>& cases,
+		                std::map<std::string, double>& medians, double tolerance);
+
+#endif /* BENCHMARK_H_ */
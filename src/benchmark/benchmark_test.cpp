@@ -0,0 +1,53 @@
+/*
+ * benchmark_test.cpp
+ *
+ *  Created on: Oct 21, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+
+TEST(BenchmarkTest, Percentile) {
+	std::vector<double> samples;
+	samples.push_back(3.0);
+	samples.push_back(1.0);
+	samples.push_back(4.0);
+	samples.push_back(2.0);
+	samples.push_back(5.0);
+	EXPECT_DOUBLE_EQ(percentile(samples, 50.0), 3.0);
+	EXPECT_DOUBLE_EQ(percentile(samples, 0.0), 1.0);
+	EXPECT_DOUBLE_EQ(percentile(samples, 100.0), 5.0);
+	EXPECT_DOUBLE_EQ(percentile(samples, 90.0), 4.6);
+}
+
+
+TEST(BenchmarkTest, BaselineRoundTrip) {
+	std::vector<BenchmarkCase> cases;
+	BenchmarkCase c;
+	c.name = "sweep";
+	c.xmax = 101;
+	c.maxDistance = 4;
+	c.threads = 2;
+	c.flops = 1.e9;
+	c.bytes = 0.0;
+	c.peakRSS = 1024;
+	c.samples.push_back(0.5);
+	c.samples.push_back(0.7);
+	c.samples.push_back(0.6);
+	cases.push_back(c);
+	writeBenchmarkJSON("bench_test.json", cases);
+
+	std::map<std::string, double> medians;
+	readBenchmarkBaseline("bench_test.json", medians);
+	EXPECT_EQ(medians.size(), 1);
+	EXPECT_DOUBLE_EQ(medians["sweep/xmax=101/maxDistance=4/threads=2"], 0.6);
+
+	// the same timings: no regression
+	EXPECT_EQ(compareWithBaseline(cases, medians, 0.2), 0);
+
+	// twice as slow: a regression
+	medians["sweep/xmax=101/maxDistance=4/threads=2"] = 0.3;
+	EXPECT_EQ(compareWithBaseline(cases, medians, 0.2), 1);
+	system("rm bench_test.json");
+}
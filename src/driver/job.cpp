@@ -0,0 +1,562 @@
+/*
+ * job.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#include "job.h"
+#include "../IO/textIO.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+#include "../recursiveCalculation/checkpointRecursion.h"
+#include "../recursiveCalculation/hodlr.h"
+#include "../directCalculation/direct_calculation.h"
+#include "../sparseCalculation/sparseSolver.h"
+#include "../freeParticle/freeParticle.h"
+#include "../dysonCalculation/dyson.h"
+#include "../IO/configParser.h"
+#include "../Utility/blockMemory.h"
+#include <ctime>
+#include <cstdio>
+#include <iomanip>
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+JobData defaultJobData() {
+	JobData job;
+	job.xmax = 101;
+	InteractionData interactionData = { 2.5, 1.0, 1.0,
+			                            true, false, false,
+			                            4, 100,
+			                            true, true};
+	job.interactionData = interactionData;
+	job.Emin = 0.0;
+	job.Emax = 0.0;
+	job.numE = 1;
+	job.eta = 0.01;
+	job.initialSite1 = 50;
+	job.initialSite2 = 51;
+	job.engine = "recursive";
+	job.mode = "green";
+	job.output = "run";
+	job.format = "bin";
+	job.threads = 0;
+	job.checkpoints = 0;
+	job.compression = 0.0;
+	job.spillTolerance = -1.0;
+	job.hugePages = false;
+	job.pinWorkers = false;
+	return job;
+}
+
+
+void readJobList(std::string filename, const JobData& defaults,
+		         std::vector<JobData>& jobs, int& workers) {
+	InputConfig config;
+	config.read(filename);
+
+	const InteractionData& data = defaults.interactionData;
+	JobData job = defaults;
+	job.interactionData.onsiteE = config.getDouble("onsiteE", data.onsiteE);
+	job.interactionData.hop = config.getDouble("hop", data.hop);
+	job.interactionData.dyn = config.getDouble("dyn", data.dyn);
+	job.interactionData.randomOnSite = config.getBool("randomOnsite", data.randomOnSite);
+	job.interactionData.randomHop = config.getBool("randomHop", data.randomHop);
+	job.interactionData.randomDyn = config.getBool("randomDyn", data.randomDyn);
+	job.interactionData.longRangeHop = config.getBool("longRangeHop", data.longRangeHop);
+	job.interactionData.longRangeDyn = config.getBool("longRangeDyn", data.longRangeDyn);
+	job.Emin = config.getDouble("Emin", defaults.Emin);
+	job.Emax = config.getDouble("Emax", defaults.Emax);
+	job.numE = config.getInt("numE", defaults.numE);
+	job.initialSite1 = config.getInt("initialSite1", defaults.initialSite1);
+	job.initialSite2 = config.getInt("initialSite2", defaults.initialSite2);
+	job.engine = config.getString("engine", defaults.engine);
+	job.mode = config.getString("mode", defaults.mode);
+	job.output = config.getString("output", defaults.output);
+	job.format = config.getString("format", defaults.format);
+	job.threads = config.getInt("threads", defaults.threads);
+	job.checkpoints = config.getInt("checkpoints", defaults.checkpoints);
+	job.compression = config.getDouble("compression", defaults.compression);
+	job.spillTolerance = config.getDouble("spillTolerance", defaults.spillTolerance);
+	job.hugePages = config.getBool("hugePages", defaults.hugePages);
+	job.pinWorkers = config.getBool("pinWorkers", defaults.pinWorkers);
+	workers = config.getInt("workers", 1);
+	if (workers < 1) {
+		std::cout << "Invalid job file " << filename << ": workers must be >= 1"
+				  << std::endl;
+		exit(-1);
+	}
+
+	// the variables that may be sweeps
+	std::vector<int> xmaxList = config.getIntList("xmax", defaults.xmax);
+	std::vector<int> maxDistanceList = config.getIntList("maxDistance", data.maxDistance);
+	std::vector<unsigned> seedList = config.getUnsignedList("seed", data.seed);
+	std::vector<double> etaList = config.getDoubleList("eta", defaults.eta);
+	std::vector<double> EList;
+	if (config.has("E")) {
+		if (config.has("Emin") || config.has("Emax") || config.has("numE")) {
+			std::cout << "Invalid job file " << filename
+					  << ": give either E or Emin/Emax/numE" << std::endl;
+			exit(-1);
+		}
+		EList = config.getDoubleList("E", 0.0);
+	}
+
+	jobs.clear();
+	for (int ix=0; ix<xmaxList.size(); ++ix) {
+		for (int id=0; id<maxDistanceList.size(); ++id) {
+			for (int is=0; is<seedList.size(); ++is) {
+				for (int ie=0; ie<etaList.size(); ++ie) {
+					job.xmax = xmaxList[ix];
+					job.interactionData.maxDistance = maxDistanceList[id];
+					job.interactionData.seed = seedList[is];
+					job.eta = etaList[ie];
+					if (EList.empty()) {
+						jobs.push_back(job);
+						continue;
+					}
+					for (int iE=0; iE<EList.size(); ++iE) {
+						job.Emin = EList[iE];
+						job.Emax = EList[iE];
+						job.numE = 1;
+						jobs.push_back(job);
+					}
+				}
+			}
+		}
+	}
+
+	for (int i=0; i<jobs.size(); ++i) {
+		if (jobs.size() > 1) {
+			jobs[i].output = job.output + "_" + itos(i);
+		}
+		std::string error = validateJob(jobs[i]);
+		if (!error.empty()) {
+			std::cout << "Invalid job file " << filename << " (job " << i << "): "
+					  << error << std::endl;
+			exit(-1);
+		}
+	}
+}
+
+
+void readJobFile(std::string filename, JobData& job) {
+	std::vector<JobData> jobs;
+	int workers;
+	readJobList(filename, job, jobs, workers);
+	if (jobs.size() != 1) {
+		std::cout << "The job file " << filename << " describes " << jobs.size()
+				  << " jobs instead of one" << std::endl;
+		exit(-1);
+	}
+	job = jobs[0];
+}
+
+
+/**
+ * the engine that runs the job (auto is replaced by free, dyson or recursive)
+ */
+static std::string selectEngine(const JobData& job) {
+	if (job.engine != "auto") return job.engine;
+	if (isNoninteracting(job.interactionData)) {
+		return "free";
+	} else if (isDysonApplicable(job.interactionData)
+			   && !job.interactionData.longRangeDyn && job.mode != "dosAll") {
+		return "dyson";
+	}
+	return "recursive";
+}
+
+
+std::string validateJob(const JobData& job) {
+	if (job.xmax < 2) {
+		return "xmax must be >= 2";
+	}
+	if (job.interactionData.maxDistance < 1) {
+		return "maxDistance must be >= 1";
+	}
+	if (job.numE < 1) {
+		return "numE must be >= 1";
+	}
+	if (job.eta <= 0.0) {
+		return "eta must be > 0";
+	}
+	if (job.initialSite1 < 0 || job.initialSite2 > job.xmax
+			|| job.initialSite1 >= job.initialSite2) {
+		return "the initial sites must satisfy 0 <= initialSite1 < initialSite2 <= xmax";
+	}
+	if (job.engine != "recursive" && job.engine != "direct" && job.engine != "sparse"
+			&& job.engine != "free" && job.engine != "dyson" && job.engine != "auto") {
+		return "unknown engine " + job.engine
+				+ " (recursive, direct, sparse, free, dyson or auto)";
+	}
+	if (job.engine == "free" && !isNoninteracting(job.interactionData)) {
+		return "the free engine needs dyn = 0 and hopping between nearest neighbors only";
+	}
+	if (job.engine == "dyson" && !isDysonApplicable(job.interactionData)) {
+		return "the dyson engine needs hopping between nearest neighbors only";
+	}
+	if (job.mode != "green" && job.mode != "dos" && job.mode != "dosAll") {
+		return "unknown mode " + job.mode + " (green, dos or dosAll)";
+	}
+	if (job.mode == "dosAll" && (job.engine == "sparse" || job.engine == "dyson")) {
+		return "the " + job.engine + " engine has no dosAll mode";
+	}
+	std::string engine = selectEngine(job);
+	if (engine == "recursive" && job.mode != "dosAll") {
+		/*
+		 * V_{KCenter} holds the initial sites. The left recursion needs
+		 * KCenter > 1, and the right one starts at KRightStart >=
+		 * KRightStop + maxDistance = KCenter + 2*maxDistance, which must be
+		 * <= Kmax = 2*xmax-1 (dosAll skips the sites next to the edges itself)
+		 */
+		int maxDistance = job.interactionData.maxDistance;
+		int Kc = job.initialSite1 + job.initialSite2;
+		int KCenter = 1 + (Kc-1)/maxDistance*maxDistance;
+		if (KCenter == 1) {
+			return "the recursive engine needs initialSite1 + initialSite2 > maxDistance";
+		}
+		if (KCenter + 2*maxDistance > 2*job.xmax - 1) {
+			int KCenterMax = 1 + (2*job.xmax - 2 - 2*maxDistance)/maxDistance*maxDistance;
+			return "the recursive engine needs initialSite1 + initialSite2 <= "
+					+ itos(KCenterMax + maxDistance - 1);
+		}
+	}
+	if (job.spillTolerance >= 0.0 && !(engine == "recursive" && job.mode == "green"
+			&& job.checkpoints == 0 && job.compression == 0.0)) {
+		return "spillTolerance is only used by the recursive engine in green mode "
+				"without checkpoints or compression";
+	}
+	if (job.hugePages && engine != "recursive") {
+		return "hugePages is only used by the recursive engine";
+	}
+	if (job.format != "bin" && job.format != "txt") {
+		return "unknown format " + job.format + " (bin or txt)";
+	}
+	if (job.threads < 0) {
+		return "threads must be >= 0";
+	}
+	if (job.checkpoints < -1) {
+		return "checkpoints must be >= -1";
+	}
+	if (job.compression < 0.0) {
+		return "compression must be >= 0";
+	}
+	if (job.checkpoints != 0 && job.compression > 0.0) {
+		return "give either checkpoints or compression";
+	}
+	return "";
+}
+
+
+void energyGrid(const JobData& job, std::vector<dcomplex>& zList) {
+	zList.clear();
+	if (job.numE == 1) {
+		zList.push_back(dcomplex(job.Emin, job.eta));
+		return;
+	}
+	std::vector<double> EList = linspace(job.Emin, job.Emax, job.numE);
+	for (int i=0; i<EList.size(); ++i) {
+		zList.push_back(dcomplex(EList[i], job.eta));
+	}
+}
+
+
+std::vector<std::string> outputFiles(const JobData& job) {
+	std::vector<std::string> files;
+	if (job.mode == "dos") {
+		// the density of state at the initial sites for all energies
+		files.push_back(job.output + "_dos.txt");
+		return files;
+	}
+	for (int i=0; i<job.numE; ++i) {
+		if (job.mode == "green") {
+			files.push_back(job.output + "_gf_" + itos(i) + "." + job.format);
+		} else {
+			files.push_back(job.output + "_dos_" + itos(i) + ".txt");
+		}
+	}
+	return files;
+}
+
+
+/**
+ * write E and the density of state in two columns
+ */
+static void saveDensityOfState(std::string filename,
+		const std::vector<dcomplex>& zList, const std::vector<double>& rhoList) {
+	std::ofstream out(filename.c_str());
+	out << std::setprecision(15);
+	for (int i=0; i<zList.size(); ++i) {
+		out << zList[i].real() << "\t" << rhoList[i] << std::endl;
+	}
+	out.close();
+}
+
+
+void runJob(JobData& job, RunManifest& manifest) {
+	time_t now = time(NULL);
+	std::string date = ctime(&now);
+	manifest.startTime = date.substr(0, date.size()-1); // remove the newline
+
+#ifdef _OPENMP
+	if (job.threads > 0) {
+		omp_set_num_threads(job.threads);
+	}
+#endif
+	setHugePages(job.hugePages);
+
+	double start = wallTime();
+	LatticeShape lattice(1);
+	lattice.setXmax(job.xmax);
+	setUpIndexInteractions(lattice, job.interactionData);
+	manifest.setupSeconds = wallTime() - start;
+
+	Basis initialSites(job.initialSite1, job.initialSite2);
+	std::vector<dcomplex> zList;
+	energyGrid(job, zList);
+	std::vector<std::string> files = outputFiles(job);
+
+	job.engine = selectEngine(job);
+
+	start = wallTime();
+	if (job.mode == "green") {
+		if (job.engine == "free") {
+			calculateAllGreenFunc_free(lattice, initialSites, zList, files);
+		} else if (job.engine == "dyson") {
+			calculateAllGreenFunc_dyson(lattice, initialSites, zList, files);
+		} else if (job.engine == "recursive" && job.compression > 0.0) {
+			CompressionData data = {job.compression, 32};
+			calculateAllGreenFuncCompressed(lattice, initialSites, job.interactionData,
+					zList, files, data);
+		} else if (job.engine == "recursive" && job.checkpoints != 0) {
+			calculateAllGreenFuncCheckpointed(lattice, initialSites, job.interactionData,
+					zList, files, max(job.checkpoints, 0));
+		} else if (job.engine == "recursive") {
+			calculateAllGreenFunc(lattice, initialSites, job.interactionData,
+					zList, files, job.spillTolerance);
+		} else if (job.engine == "direct") {
+			calculateAllGreenFunc_direct(lattice, initialSites, zList, files);
+		} else {
+			calculateAllGreenFunc_sparse(lattice, initialSites, zList, files);
+		}
+	} else if (job.mode == "dos") {
+		std::vector<double> rhoList;
+		if (job.engine == "free") {
+			densityOfState_free(lattice, initialSites, zList, rhoList);
+		} else if (job.engine == "dyson") {
+			densityOfState_dyson(lattice, initialSites, zList, rhoList);
+		} else if (job.engine == "recursive") {
+			calculateDensityOfState(lattice, initialSites, job.interactionData,
+					zList, rhoList);
+		} else if (job.engine == "direct") {
+			densityOfState_direct(lattice, initialSites, zList, rhoList);
+		} else {
+			std::vector<dcomplex> gfList;
+			greenFunc_sparse(lattice, initialSites, initialSites, zList, gfList);
+			rhoList.clear();
+			for (int i=0; i<gfList.size(); ++i) {
+				rhoList.push_back(-gfList[i].imag()/M_PI);
+			}
+		}
+		saveDensityOfState(files[0], zList, rhoList);
+	} else {
+		if (job.engine == "free") {
+			densityOfStateAll_free(lattice, zList, files);
+		} else if (job.engine == "recursive") {
+			calculateDensityOfStateAll(lattice, job.interactionData, zList, files);
+		} else {
+			densityOfStateAll_direct(lattice, zList, files);
+		}
+	}
+	manifest.computeSeconds = wallTime() - start;
+	manifest.peakRSS = peakResidentMemory();
+	manifest.outputs = files;
+}
+
+
+/**
+ * remove a directory and everything in it (without a shell, so that any
+ * character in the path is fine)
+ */
+static bool removeDirectory(std::string path) {
+	DIR* dir = opendir(path.c_str());
+	if (dir == NULL) return false;
+	bool removed = true;
+	struct dirent* entry;
+	while ((entry = readdir(dir)) != NULL) {
+		std::string name = entry->d_name;
+		if (name == "." || name == "..") continue;
+		std::string file = path + "/" + name;
+		struct stat info;
+		if (lstat(file.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+			removed = removeDirectory(file) && removed;
+		} else {
+			removed = (unlink(file.c_str()) == 0) && removed;
+		}
+	}
+	closedir(dir);
+	return (rmdir(path.c_str()) == 0) && removed;
+}
+
+
+/**
+ * run one job in the scratch directory <cwd>/.job_<index>_<pid> (the outputs
+ * and the manifest still go to the current directory); the pid keeps it apart
+ * from the directories of other runs, including the ones left by a crash
+ */
+static int runJobInScratch(JobData job, int index, std::string jobFile) {
+	char buffer[4096];
+	if (getcwd(buffer, sizeof(buffer)) == NULL) {
+		std::cout << "Cannot get the current directory" << std::endl;
+		return -1;
+	}
+	std::string cwd = buffer;
+	if (job.output.empty() || job.output[0] != '/') {
+		job.output = cwd + "/" + job.output;
+	}
+
+	std::string scratch = cwd + "/.job_" + itos(index) + "_" + itos(getpid());
+	if (mkdir(scratch.c_str(), 0755) != 0 || chdir(scratch.c_str()) != 0) {
+		std::cout << "Cannot use the scratch directory " << scratch << std::endl;
+		return -1;
+	}
+
+	RunManifest manifest;
+	manifest.jobFile = jobFile;
+	runJob(job, manifest);
+	writeRunManifest(job.output + "_manifest.json", job, manifest);
+
+	if (chdir(cwd.c_str()) != 0) return -1;
+	return removeDirectory(scratch) ? 0 : -1;
+}
+
+
+/**
+ * wait for a job to finish and free its worker
+ */
+static void waitForJob(std::vector<pid_t>& pids, int& running, int& failed) {
+	int status;
+	pid_t pid;
+	do {
+		pid = wait(&status);
+	} while (pid < 0 && errno == EINTR);
+	if (pid < 0) {
+		// no child is left, so the jobs counted as running are lost
+		std::cout << "Cannot wait for the running jobs" << std::endl;
+		failed += running;
+		running = 0;
+		std::fill(pids.begin(), pids.end(), 0);
+		return;
+	}
+	for (int w=0; w<pids.size(); ++w) {
+		if (pids[w] == pid) pids[w] = 0;
+	}
+	--running;
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ++failed;
+}
+
+
+int runJobs(std::vector<JobData>& jobs, int workers, std::string jobFile) {
+	int failed = 0;
+	int running = 0;
+	std::vector<pid_t> pids(workers, 0); // the job run by each worker
+	for (int i=0; i<jobs.size(); ++i) {
+		if (running == workers) {
+			waitForJob(pids, running, failed);
+		}
+		int worker = std::find(pids.begin(), pids.end(), 0) - pids.begin();
+
+		// don't let the child flush the output buffered by the parent again
+		std::cout.flush();
+		fflush(stdout);
+		pid_t pid = fork();
+		if (pid < 0) {
+			std::cout << "Cannot fork job " << i << std::endl;
+			++failed;
+			continue;
+		}
+		if (pid == 0) {
+			// before any thread exists, so that the OpenMP threads follow
+			if (jobs[i].pinWorkers && !pinToNode(worker % numaNodes())) {
+				std::cout << "Cannot pin job " << i << " to NUMA node "
+						  << worker % numaNodes() << std::endl;
+			}
+			int result = runJobInScratch(jobs[i], i, jobFile);
+			std::cout.flush();
+			_exit(result == 0 ? 0 : 1);
+		}
+		pids[worker] = pid;
+		++running;
+	}
+
+	while (running > 0) {
+		waitForJob(pids, running, failed);
+	}
+	return failed;
+}
+
+
+void writeRunManifest(std::string filename, const JobData& job,
+		              const RunManifest& manifest) {
+	std::ofstream out(filename.c_str());
+	if (!out) {
+		std::cout << "Cannot open " << filename << " for the run manifest" << std::endl;
+		exit(-1);
+	}
+	char host[256] = "unknown";
+	gethostname(host, sizeof(host));
+	host[sizeof(host)-1] = '\0';
+
+	int threads = 1;
+#ifdef _OPENMP
+	threads = omp_get_max_threads();
+#endif
+
+	const InteractionData& data = job.interactionData;
+	out << std::setprecision(15) << std::boolalpha;
+	out << "{\n";
+	out << "  \"jobFile\": \"" << manifest.jobFile << "\",\n";
+	out << "  \"host\": \"" << host << "\",\n";
+	out << "  \"startTime\": \"" << manifest.startTime << "\",\n";
+	out << "  \"threads\": " << threads << ",\n";
+	out << "  \"xmax\": " << job.xmax << ",\n";
+	out << "  \"onsiteE\": " << data.onsiteE << ",\n";
+	out << "  \"hop\": " << data.hop << ",\n";
+	out << "  \"dyn\": " << data.dyn << ",\n";
+	out << "  \"randomOnsite\": " << data.randomOnSite << ",\n";
+	out << "  \"randomHop\": " << data.randomHop << ",\n";
+	out << "  \"randomDyn\": " << data.randomDyn << ",\n";
+	out << "  \"maxDistance\": " << data.maxDistance << ",\n";
+	out << "  \"seed\": " << data.seed << ",\n";
+	out << "  \"longRangeHop\": " << data.longRangeHop << ",\n";
+	out << "  \"longRangeDyn\": " << data.longRangeDyn << ",\n";
+	out << "  \"Emin\": " << job.Emin << ",\n";
+	out << "  \"Emax\": " << job.Emax << ",\n";
+	out << "  \"numE\": " << job.numE << ",\n";
+	out << "  \"eta\": " << job.eta << ",\n";
+	out << "  \"initialSites\": [" << job.initialSite1 << ", "
+		<< job.initialSite2 << "],\n";
+	out << "  \"engine\": \"" << job.engine << "\",\n";
+	out << "  \"mode\": \"" << job.mode << "\",\n";
+	out << "  \"setupSeconds\": " << manifest.setupSeconds << ",\n";
+	out << "  \"computeSeconds\": " << manifest.computeSeconds << ",\n";
+	out << "  \"secondsPerEnergy\": " << manifest.computeSeconds/job.numE << ",\n";
+	out << "  \"peakRSS\": " << manifest.peakRSS << ",\n";
+	out << "  \"outputs\": [";
+	for (int i=0; i<manifest.outputs.size(); ++i) {
+		out << (i>0 ? ", " : "") << "\"" << manifest.outputs[i] << "\"";
+	}
+	out << "]\n";
+	out << "}\n";
+	out.close();
+}
@@ -0,0 +1,169 @@
+/*
+ * job.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ *
+ * A job is one production calculation described by a job file in the same
+ * "type name value" format as input.txt, for example
+ *
+ *   int xmax 101
+ *   double onsiteE 2.5
+ *   double hop 1.0
+ *   double dyn 1.0
+ *   bool randomOnsite true
+ *   bool randomHop false
+ *   bool randomDyn false
+ *   unsigned seed 100
+ *   bool longRangeHop true
+ *   bool longRangeDyn true
+ *   int maxDistance 4
+ *   double Emin -1.0
+ *   double Emax 1.0
+ *   int numE 21
+ *   double eta 0.01
+ *   int initialSite1 50
+ *   int initialSite2 51
+ *   string engine recursive      (recursive, direct, sparse, free, dyson or auto)
+ *   string mode green            (green, dos or dosAll)
+ *   string output run            (prefix of the output files)
+ *   string format bin            (bin or txt)
+ *   int threads 0                (0 keeps the OpenMP default)
+ *   int checkpoints 0            (recursive green mode: 0 saves every A to the
+ *                                 disk, n > 0 keeps n checkpoints in memory
+ *                                 and recomputes the rest, -1 picks sqrt)
+ *   double compression 0         (recursive green mode: > 0 keeps the A matrices
+ *                                 in memory in HODLR form to this tolerance)
+ *   double spillTolerance -1     (recursive green mode: the A matrices on the
+ *                                 disk are raw (< 0), deflated (0) or rounded
+ *                                 to this relative tolerance, see IO/spillStore.h)
+ *   bool hugePages false         (recursive engine: put the block buffers and
+ *                                 the A blocks of the recursion on transparent
+ *                                 huge pages)
+ *   bool pinWorkers false        (bind worker w to the CPUs of NUMA node
+ *                                 w % nodes, so that its memory is local,
+ *                                 see Utility/blockMemory.h)
+ *   int workers 1                (number of jobs that run at the same time)
+ *
+ * Lines that are missing keep the default values of defaultJobData().
+ *
+ * The recursive engine cannot start from initial sites next to the edges:
+ * in the green and dos modes it needs initialSite1 + initialSite2 >
+ * maxDistance, and the sum must stay about 2*maxDistance below 2*xmax (see
+ * validateJob). spillTolerance and hugePages are refused for the engines and
+ * modes that do not use them.
+ *
+ * The free engine uses the single-particle eigenstates (see
+ * freeParticle/freeParticle.h) and needs dyn = 0 and hopping between nearest
+ * neighbors. The dyson engine (see dysonCalculation/dyson.h) adds the dynamic
+ * interaction to it and only needs the nearest-neighbor hopping. auto picks
+ * free, then dyson when the dynamic interaction is short ranged
+ * (longRangeDyn false), and the recursive engine otherwise.
+ *
+ * xmax, maxDistance, seed, E and eta may be sweeps (see IO/configParser.h),
+ * e.g. "unsigned seed 1:1:50"; the file then describes the list of jobs of
+ * all the combinations, each with the output prefix <output>_<job index>.
+ * A sweep over E gives one job per energy (instead of Emin/Emax/numE).
+ */
+
+#ifndef JOB_H_
+#define JOB_H_
+
+#include <string>
+#include <vector>
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../basis_set/basis.h"
+#include "../formMatrix/formMatrix.h"
+
+
+typedef struct {
+	int xmax;
+	InteractionData interactionData;
+	// the energy grid z = E + i*eta with E = linspace(Emin, Emax, numE)
+	double Emin, Emax;
+	int numE;
+	double eta;
+	// the initial sites (initialSite1 < initialSite2)
+	int initialSite1, initialSite2;
+	std::string engine;
+	std::string mode;
+	std::string output;
+	std::string format;
+	int threads;
+	// see recursiveCalculation/checkpointRecursion.h
+	int checkpoints;
+	// see recursiveCalculation/hodlr.h
+	double compression;
+	double spillTolerance;
+	// see Utility/blockMemory.h
+	bool hugePages;
+	bool pinWorkers;
+} JobData;
+
+
+typedef struct {
+	std::string jobFile;
+	std::string startTime;
+	double setupSeconds; // index matrices and interactions
+	double computeSeconds; // the engine, including writing the outputs
+	long peakRSS; // kB
+	std::vector<std::string> outputs;
+} RunManifest;
+
+
+JobData defaultJobData();
+
+/**
+ * expand the job file into a list of jobs on top of the defaults and check
+ * them; an invalid job stops the program
+ */
+void readJobList(std::string filename, const JobData& defaults,
+		         std::vector<JobData>& jobs, int& workers);
+
+/**
+ * same as readJobList for a job file that contains no sweep
+ */
+void readJobFile(std::string filename, JobData& job);
+
+/**
+ * return an empty string if the job is valid, otherwise the reason why not
+ */
+std::string validateJob(const JobData& job);
+
+/**
+ * the complex energies z = E + i*eta of the energy grid
+ */
+void energyGrid(const JobData& job, std::vector<dcomplex>& zList);
+
+/**
+ * the output files of the job (one per energy for the green and dosAll
+ * modes, a single file for the dos mode)
+ */
+std::vector<std::string> outputFiles(const JobData& job);
+
+/**
+ * set up the lattice and the interactions, run the engine and fill the
+ * timings of the manifest (engine auto is replaced by the engine that was run)
+ */
+void runJob(JobData& job, RunManifest& manifest);
+
+/**
+ * run a list of jobs with at most "workers" of them at the same time and
+ * write the manifest <output>_manifest.json of each; return the number of
+ * jobs that failed
+ *
+ * The engines keep their state in global variables and write the A matrices
+ * into the current directory, so each job runs in a forked process inside
+ * its own scratch directory. The workers are numbered 0, ..., workers-1; a
+ * job with pinWorkers runs on the NUMA node of its worker.
+ */
+int runJobs(std::vector<JobData>& jobs, int workers, std::string jobFile);
+
+/**
+ * save the job parameters, the outputs and the timings in JSON format
+ */
+void writeRunManifest(std::string filename, const JobData& job,
+		              const RunManifest& manifest);
+
+#endif /* JOB_H_ */
@@ -0,0 +1,272 @@
+/*
+ * job_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "job.h"
+#include "../IO/MatrixIO.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+#include <dirent.h>
+#include <sys/stat.h>
+
+
+/**
+ * the entries of the current directory whose name starts with prefix
+ */
+static int countEntries(std::string prefix) {
+	DIR* dir = opendir(".");
+	int count = 0;
+	struct dirent* entry;
+	while ((entry = readdir(dir)) != NULL) {
+		if (std::string(entry->d_name).compare(0, prefix.size(), prefix) == 0) count++;
+	}
+	closedir(dir);
+	return count;
+}
+
+
+TEST(JobTest, ReadAndValidate) {
+	std::ofstream myfile("job_test.txt");
+	myfile << "int xmax 21" << std::endl;
+	myfile << "int maxDistance 2" << std::endl;
+	myfile << "unsigned seed 7" << std::endl;
+	myfile << "double Emin -1.0" << std::endl;
+	myfile << "double Emax 1.0" << std::endl;
+	myfile << "int numE 5" << std::endl;
+	myfile << "int initialSite1 10" << std::endl;
+	myfile << "int initialSite2 11" << std::endl;
+	myfile << "string engine direct" << std::endl;
+	myfile << "string output jobtest" << std::endl;
+	myfile.close();
+
+	JobData job = defaultJobData();
+	readJobFile("job_test.txt", job);
+	remove("job_test.txt");
+
+	EXPECT_EQ(job.xmax, 21);
+	EXPECT_EQ(job.interactionData.maxDistance, 2);
+	EXPECT_EQ(job.interactionData.seed, 7);
+	EXPECT_EQ(job.engine, "direct");
+	EXPECT_EQ(job.mode, "green");
+	EXPECT_EQ(validateJob(job), "");
+
+	std::vector<dcomplex> zList;
+	energyGrid(job, zList);
+	ASSERT_EQ(zList.size(), 5);
+	EXPECT_DOUBLE_EQ(zList[0].real(), -1.0);
+	EXPECT_DOUBLE_EQ(zList[4].real(), 1.0);
+	EXPECT_DOUBLE_EQ(zList[2].imag(), job.eta);
+
+	std::vector<std::string> files = outputFiles(job);
+	ASSERT_EQ(files.size(), 5);
+	EXPECT_EQ(files[3], "jobtest_gf_3.bin");
+
+	job.initialSite2 = 22;
+	EXPECT_NE(validateJob(job), "");
+	job.initialSite2 = 11;
+	job.engine = "sparse";
+	job.mode = "dosAll";
+	EXPECT_NE(validateJob(job), "");
+	job.engine = "free";
+	EXPECT_NE(validateJob(job), ""); // dyn != 0
+	job.engine = "dyson";
+	EXPECT_NE(validateJob(job), ""); // long-range hopping
+}
+
+
+TEST(JobTest, AutoPicksFree) {
+	JobData job = defaultJobData();
+	job.xmax = 15;
+	job.interactionData.dyn = 0.0;
+	job.interactionData.longRangeHop = false;
+	job.initialSite1 = 7;
+	job.initialSite2 = 8;
+	job.Emin = 0.3;
+	job.eta = 0.1;
+	job.output = "jobtest_auto";
+	job.engine = "auto";
+	ASSERT_EQ(validateJob(job), "");
+
+	RunManifest manifest;
+	manifest.jobFile = "none";
+	runJob(job, manifest);
+	EXPECT_EQ(job.engine, "free");
+	CDMatrix gfFree;
+	loadMatrix(manifest.outputs[0], gfFree);
+
+	job.engine = "recursive";
+	job.output = "jobtest_recursive";
+	RunManifest manifestRecursive;
+	manifestRecursive.jobFile = "none";
+	runJob(job, manifestRecursive);
+	CDMatrix gfRecursive;
+	loadMatrix(manifestRecursive.outputs[0], gfRecursive);
+
+	EXPECT_LT((gfFree-gfRecursive).norm(), 1e-8*gfRecursive.norm());
+	deleteMatrixFiles("jobtest_*");
+}
+
+
+TEST(JobTest, RunMatchesEngines) {
+	JobData job = defaultJobData();
+	job.xmax = 15;
+	job.interactionData.maxDistance = 2;
+	job.initialSite1 = 7;
+	job.initialSite2 = 8;
+	job.Emin = 0.3;
+	job.Emax = 0.3;
+	job.eta = 0.1;
+	job.output = "jobtest_recursive";
+
+	RunManifest manifest;
+	manifest.jobFile = "none";
+	runJob(job, manifest);
+	ASSERT_EQ(manifest.outputs.size(), 1);
+	CDMatrix gfRecursive;
+	loadMatrix(manifest.outputs[0], gfRecursive);
+
+	job.engine = "direct";
+	job.output = "jobtest_direct";
+	RunManifest manifestDirect;
+	manifestDirect.jobFile = "none";
+	runJob(job, manifestDirect);
+	CDMatrix gfDirect;
+	loadMatrix(manifestDirect.outputs[0], gfDirect);
+
+	EXPECT_LT((gfRecursive-gfDirect).norm(), 1e-8*gfDirect.norm());
+
+	job.engine = "recursive";
+	job.checkpoints = -1;
+	job.output = "jobtest_checkpoint";
+	RunManifest manifestCheckpoint;
+	manifestCheckpoint.jobFile = "none";
+	runJob(job, manifestCheckpoint);
+	CDMatrix gfCheckpoint;
+	loadMatrix(manifestCheckpoint.outputs[0], gfCheckpoint);
+	EXPECT_LT((gfCheckpoint-gfRecursive).norm(), 1e-12*gfRecursive.norm());
+	job.compression = 1e-10;
+	EXPECT_NE(validateJob(job), ""); // both checkpoints and compression
+	job.checkpoints = 0;
+	job.output = "jobtest_compressed";
+	RunManifest manifestCompressed;
+	manifestCompressed.jobFile = "none";
+	runJob(job, manifestCompressed);
+	CDMatrix gfCompressed;
+	loadMatrix(manifestCompressed.outputs[0], gfCompressed);
+	EXPECT_LT((gfCompressed-gfRecursive).norm(), 1e-8*gfRecursive.norm());
+	job.compression = 0.0;
+	job.spillTolerance = 0.0;
+	job.output = "jobtest_spill";
+	RunManifest manifestSpill;
+	manifestSpill.jobFile = "none";
+	runJob(job, manifestSpill);
+	CDMatrix gfSpill;
+	loadMatrix(manifestSpill.outputs[0], gfSpill);
+	EXPECT_TRUE(gfSpill == gfRecursive);
+	job.spillTolerance = -1.0;
+	job.engine = "direct";
+
+	writeRunManifest("jobtest_manifest.json", job, manifestDirect);
+	std::ifstream in("jobtest_manifest.json");
+	std::string content((std::istreambuf_iterator<char>(in)),
+			std::istreambuf_iterator<char>());
+	in.close();
+	EXPECT_NE(content.find("\"engine\": \"direct\""), std::string::npos);
+	EXPECT_NE(content.find("\"outputs\": [\"jobtest_direct_gf_0.bin\"]"),
+			std::string::npos);
+
+	deleteMatrixFiles("jobtest_*");
+}
+
+
+TEST(JobTest, SweepInParallel) {
+	std::ofstream myfile("job_sweep.txt");
+	myfile << "int xmax 15" << std::endl;
+	myfile << "int maxDistance 2" << std::endl;
+	myfile << "unsigned seed 1:1:3" << std::endl;
+	myfile << "double E -0.5,0.5" << std::endl;
+	myfile << "double eta 0.1" << std::endl;
+	myfile << "int initialSite1 7" << std::endl;
+	myfile << "int initialSite2 8" << std::endl;
+	myfile << "string mode dos" << std::endl;
+	myfile << "string output jobsweep" << std::endl;
+	myfile << "int workers 3" << std::endl;
+	myfile << "bool hugePages true" << std::endl;
+	myfile << "bool pinWorkers true" << std::endl;
+	myfile.close();
+
+	std::vector<JobData> jobs;
+	int workers;
+	readJobList("job_sweep.txt", defaultJobData(), jobs, workers);
+	remove("job_sweep.txt");
+	ASSERT_EQ(jobs.size(), 6);
+	EXPECT_EQ(workers, 3);
+	EXPECT_EQ(jobs[3].interactionData.seed, 2);
+	EXPECT_DOUBLE_EQ(jobs[3].Emin, 0.5);
+	EXPECT_EQ(jobs[3].output, "jobsweep_3");
+	EXPECT_TRUE(jobs[3].hugePages);
+	EXPECT_TRUE(jobs[3].pinWorkers);
+
+	// a scratch directory left over by a crashed run is in the way
+	mkdir(".job_0", 0755);
+	EXPECT_EQ(runJobs(jobs, workers, "job_sweep.txt"), 0);
+	EXPECT_EQ(countEntries(".job_"), 1);
+	rmdir(".job_0");
+
+	// every job gives the same result as running it alone
+	for (int i=0; i<jobs.size(); ++i) {
+		std::ifstream in(("jobsweep_" + itos(i) + "_dos.txt").c_str());
+		double E, rho;
+		ASSERT_TRUE(in >> E >> rho);
+		in.close();
+
+		LatticeShape lattice(1);
+		lattice.setXmax(jobs[i].xmax);
+		setUpIndexInteractions(lattice, jobs[i].interactionData);
+		Basis initialSites(7, 8);
+		std::vector<dcomplex> zList(1, dcomplex(jobs[i].Emin, jobs[i].eta));
+		std::vector<double> rhoList;
+		calculateDensityOfState(lattice, initialSites, jobs[i].interactionData,
+				zList, rhoList);
+		EXPECT_DOUBLE_EQ(E, jobs[i].Emin);
+		EXPECT_NEAR(rho, rhoList[0], 1e-12*std::abs(rhoList[0]));
+	}
+	deleteMatrixFiles("jobsweep_*");
+}
+
+
+TEST(JobTest, RecursiveNeedsRoomAtTheEdges) {
+	JobData job = defaultJobData();
+	job.xmax = 20;
+	job.interactionData.maxDistance = 3;
+	job.initialSite1 = 0;
+	job.initialSite2 = 3;
+	EXPECT_NE(validateJob(job), ""); // KCenter = 1
+	job.initialSite2 = 4;
+	EXPECT_EQ(validateJob(job), "");
+	job.initialSite1 = 15;
+	job.initialSite2 = 18;
+	EXPECT_EQ(validateJob(job), ""); // KCenter = 31, KRightStart = 37
+	job.initialSite2 = 19;
+	EXPECT_NE(validateJob(job), ""); // KCenter = 34, KRightStart = 40 > Kmax
+	job.mode = "dosAll";
+	EXPECT_EQ(validateJob(job), "");
+	job.engine = "direct";
+	job.mode = "green";
+	EXPECT_EQ(validateJob(job), "");
+
+	// options that the engine would ignore
+	job.hugePages = true;
+	EXPECT_NE(validateJob(job), "");
+	job.hugePages = false;
+	job.spillTolerance = 0.0;
+	EXPECT_NE(validateJob(job), "");
+	job.engine = "recursive";
+	job.initialSite2 = 18;
+	EXPECT_EQ(validateJob(job), "");
+	job.checkpoints = -1;
+	EXPECT_NE(validateJob(job), "");
+}
@@ -0,0 +1,168 @@
+/*
+ * dyson.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "dyson.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+
+
+bool isDysonApplicable(const InteractionData& interactionData) {
+	return !interactionData.longRangeHop || interactionData.maxDistance == 1;
+}
+
+
+void interactionSubspace(LatticeShape& lattice, std::vector<Basis>& subspace) {
+	extern Interaction *pInteraction;
+	int xmax = lattice.getXmax();
+	subspace.clear();
+	for (int x1=0; x1<xmax; ++x1) {
+		for (int x2=x1+1; x2<=xmax; ++x2) {
+			if (dMatrix(*pInteraction, x1, x2) != 0.0) {
+				subspace.push_back(Basis(x1, x2));
+			}
+		}
+	}
+}
+
+
+/**
+ * the coefficients C_ab = Psi_ab(y)/(z-e_a-e_b) of G0(x; y) = sum_{a,b}
+ * phi_a(x1)*C_ab*phi_b(x2)
+ */
+static void freeCoefficients(const DMatrix& states, const CDMatrix& oneOverDenominator,
+		                     Basis& y, CDMatrix& C) {
+	DMatrix psi;
+	pairStates(states, y, psi);
+	C = psi.cast<dcomplex>().cwiseProduct(oneOverDenominator);
+}
+
+
+/**
+ * G0(x; y) from phiC = Phi*C of freeCoefficients(y)
+ */
+static dcomplex freeValue(const CDMatrix& phiC, const CDMatrix& phi, Basis& x) {
+	return phiC.row(x[0]).cwiseProduct(phi.row(x[1])).sum();
+}
+
+
+/**
+ * weights(s) = d(s)*G(s; y) on the interaction subspace and, if bra is not
+ * NULL, G0(bra; S) and G0(bra; y)
+ */
+static void solveDyson(const DMatrix& states, const CDMatrix& oneOverDenominator,
+		               std::vector<Basis>& subspace, Basis& ket, Basis* bra,
+		               CDVector& weights, CDVector& G0BraS, dcomplex& G0BraKet) {
+	extern Interaction *pInteraction;
+	int m = subspace.size();
+	CDMatrix phi = states.cast<dcomplex>();
+	DVector d(m);
+	for (int i=0; i<m; ++i) {
+		d(i) = dMatrix(*pInteraction, subspace[i][0], subspace[i][1]);
+	}
+
+	// the columns G0(S; s), one O(N^3) product each
+	CDMatrix G0SS(m, m);
+	G0BraS.resize(m);
+	#pragma omp parallel for schedule(dynamic)
+	for (int j=0; j<m; ++j) {
+		CDMatrix C;
+		freeCoefficients(states, oneOverDenominator, subspace[j], C);
+		CDMatrix phiC = phi*C;
+		for (int i=0; i<m; ++i) {
+			G0SS(i, j) = freeValue(phiC, phi, subspace[i]);
+		}
+		if (bra != NULL) G0BraS(j) = freeValue(phiC, phi, *bra);
+	}
+
+	CDMatrix C;
+	freeCoefficients(states, oneOverDenominator, ket, C);
+	CDMatrix phiC = phi*C;
+	CDMatrix G0SKet(m, 1);
+	for (int i=0; i<m; ++i) {
+		G0SKet(i, 0) = freeValue(phiC, phi, subspace[i]);
+	}
+	if (bra != NULL) G0BraKet = freeValue(phiC, phi, *bra);
+
+	// (1 - G0_SS*V_S)*G(S; y) = G0(S; y)
+	CDMatrix leftSide = -G0SS*d.cast<dcomplex>().asDiagonal();
+	leftSide.diagonal().array() += 1.0;
+	CDMatrix GS;
+	solveDenseLinearEqs(leftSide, G0SKet, GS);
+	weights = d.cast<dcomplex>().cwiseProduct(GS.col(0));
+}
+
+
+void greenFunc_dyson(LatticeShape& lattice, Basis& bra, Basis& ket,
+		             std::vector<dcomplex>& zList, std::vector<dcomplex>& gfList) {
+	DVector energies;
+	DMatrix states;
+	singleParticleStates(lattice, energies, states);
+	std::vector<Basis> subspace;
+	interactionSubspace(lattice, subspace);
+
+	gfList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		CDMatrix oneOverDenominator;
+		pairDenominator(zList[i], energies, oneOverDenominator);
+		CDVector weights, G0BraS;
+		dcomplex G0BraKet;
+		solveDyson(states, oneOverDenominator, subspace, ket, &bra,
+				weights, G0BraS, G0BraKet);
+		// G0(x; s) = G0(s; x)
+		gfList.push_back(G0BraKet + G0BraS.cwiseProduct(weights).sum());
+	}
+}
+
+
+void densityOfState_dyson(LatticeShape& lattice, Basis& basis,
+		                  std::vector<dcomplex>& zList, std::vector<double>& dosList) {
+	std::vector<dcomplex> gfList;
+	greenFunc_dyson(lattice, basis, basis, zList, gfList);
+	dosList.clear();
+	for (int i=0; i<gfList.size(); ++i) {
+		dosList.push_back(-gfList[i].imag()/M_PI);
+	}
+}
+
+
+void calculateAllGreenFunc_dyson(LatticeShape& lattice, Basis& initialSites,
+		                         std::vector<dcomplex>& zList,
+		                         std::vector<std::string>& fileList) {
+	DVector energies;
+	DMatrix states;
+	singleParticleStates(lattice, energies, states);
+	std::vector<Basis> subspace;
+	interactionSubspace(lattice, subspace);
+	CDMatrix phi = states.cast<dcomplex>();
+
+	for (int i=0; i<zList.size(); ++i) {
+		CDMatrix oneOverDenominator;
+		pairDenominator(zList[i], energies, oneOverDenominator);
+		CDVector weights, G0BraS;
+		dcomplex G0BraKet;
+		solveDyson(states, oneOverDenominator, subspace, initialSites, NULL,
+				weights, G0BraS, G0BraKet);
+
+		// G0 is linear in Psi(y): G = Phi*[(Psi(y) + sum_s w_s*Psi(s)) o D]*Phi^T
+		DMatrix psi;
+		pairStates(states, initialSites, psi);
+		CDMatrix source = psi.cast<dcomplex>();
+		for (int s=0; s<subspace.size(); ++s) {
+			pairStates(states, subspace[s], psi);
+			source += weights(s)*psi.cast<dcomplex>();
+		}
+		CDMatrix gf = phi*source.cwiseProduct(oneOverDenominator)*phi.transpose();
+
+		// the same layout as the other engines: symmetric with a zero diagonal
+		for (int n1=0; n1<gf.rows(); ++n1) {
+			gf(n1, n1) = dcomplex(0, 0);
+			for (int n2=n1+1; n2<gf.cols(); ++n2) {
+				gf(n2, n1) = gf(n1, n2);
+			}
+		}
+		saveMatrix(fileList[i], gf);
+	}
+}
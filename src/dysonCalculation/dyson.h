@@ -0,0 +1,57 @@
+/*
+ * dyson.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * The dynamic interaction as a perturbation of the free particles.
+ *
+ * The dynamic interaction only changes the diagonal of the Hamiltonian,
+ * H = H0 + V with V(s, s) = d(s1, s2), and d vanishes unless
+ * s2 - s1 <= maxDistance (or 1 without longRangeDyn). On the interaction
+ * subspace S = {s : d(s) != 0} the Dyson equation G = G0 + G0*V*G closes:
+ *
+ *   (1 - G0_SS*V_S) * G(S; y) = G0(S; y)
+ *
+ *   G(x; y) = G0(x; y) + sum_{s in S} G0(x; s)*d(s)*G(s; y)
+ *
+ * so the linear system has the size of S (about maxDistance*xmax) instead of
+ * the whole basis. G0 comes from the single-particle states (see
+ * freeParticle/freeParticle.h), so the hopping must be between nearest
+ * neighbors.
+ *
+ * Before calling the functions below, call setUpIndexInteractions(lattice,
+ * interactionData) as for the direct engine.
+ */
+
+#ifndef DYSON_H_
+#define DYSON_H_
+
+#include "../freeParticle/freeParticle.h"
+
+
+/**
+ * true if the Dyson engine applies: hopping between nearest neighbors only
+ */
+bool isDysonApplicable(const InteractionData& interactionData);
+
+/**
+ * the pairs (x1, x2), x1 < x2, with d(x1, x2) != 0
+ */
+void interactionSubspace(LatticeShape& lattice, std::vector<Basis>& subspace);
+
+void greenFunc_dyson(LatticeShape& lattice, Basis& bra, Basis& ket,
+		             std::vector<dcomplex>& zList, std::vector<dcomplex>& gfList);
+
+void densityOfState_dyson(LatticeShape& lattice, Basis& basis,
+		                  std::vector<dcomplex>& zList, std::vector<double>& dosList);
+
+/**
+ * G(x1, x2; initial_sites) for all x1 < x2; the files have the same layout
+ * as those of calculateAllGreenFunc
+ */
+void calculateAllGreenFunc_dyson(LatticeShape& lattice, Basis& initialSites,
+		                         std::vector<dcomplex>& zList,
+		                         std::vector<std::string>& fileList);
+
+#endif /* DYSON_H_ */
@@ -0,0 +1,56 @@
+/*
+ * dyson_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "dyson.h"
+#include "../directCalculation/direct_calculation.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+#include "../IO/binaryIO.h"
+
+
+TEST(Dyson, SameAsDirect) {
+	LatticeShape lattice1D(1);
+	int xmax = 20;
+	lattice1D.setXmax(xmax);
+	// random dynamic interaction up to a distance of 3
+	InteractionData interactionData = {2.0,1.0,1.5,true,true,true,3,7,false,true};
+	ASSERT_TRUE(isDysonApplicable(interactionData));
+	setUpIndexInteractions(lattice1D, interactionData);
+
+	std::vector<Basis> subspace;
+	interactionSubspace(lattice1D, subspace);
+	EXPECT_EQ(subspace.size(), 3*xmax-3);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.7, 0.05));
+	zList.push_back(dcomplex(-2.5, 0.2));
+	Basis initialSites(8, 10);
+	Basis finalSites(3, 15);
+	std::vector<dcomplex> gfDirect, gfDyson;
+	greenFunc_direct(lattice1D, finalSites, initialSites, zList, gfDirect);
+	greenFunc_dyson(lattice1D, finalSites, initialSites, zList, gfDyson);
+	for (int i=0; i<zList.size(); ++i) {
+		EXPECT_NEAR(std::abs(gfDyson[i] - gfDirect[i]), 0.0, 1e-10*std::abs(gfDirect[i]));
+	}
+
+	// the whole matrix against the recursive engine
+	std::vector<std::string> recursiveFiles, dysonFiles;
+	recursiveFiles.push_back("dyson_test_recursive0.bin");
+	recursiveFiles.push_back("dyson_test_recursive1.bin");
+	dysonFiles.push_back("dyson_test_dyson0.bin");
+	dysonFiles.push_back("dyson_test_dyson1.bin");
+	calculateAllGreenFunc(lattice1D, initialSites, interactionData, zList, recursiveFiles);
+	calculateAllGreenFunc_dyson(lattice1D, initialSites, zList, dysonFiles);
+	for (int i=0; i<zList.size(); ++i) {
+		CDMatrix gfRecursive, gfAll;
+		loadMatrixBin(recursiveFiles[i], gfRecursive);
+		loadMatrixBin(dysonFiles[i], gfAll);
+		remove(recursiveFiles[i].c_str());
+		remove(dysonFiles[i].c_str());
+		EXPECT_LT((gfAll - gfRecursive).norm(), 1e-10*gfRecursive.norm());
+	}
+}
@@ -0,0 +1,317 @@
+/*
+ * ensemble.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "ensemble.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+#include <cstdio>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+
+void greenFuncLine(LatticeShape& lattice, InteractionData& interactionData,
+		           int n, int a, dcomplex z, CDVector& line) {
+	setLatticeAndInteractions(lattice, interactionData);
+
+	Basis initialSites(n, n+a);
+	std::vector<dcomplex> zList(1, z);
+	std::vector<CDVector> lineList;
+	calculateGreenFuncLine(lattice, initialSites, interactionData, zList,
+			a, n, lattice.getXmax()-a, lineList);
+	line = lineList[0];
+}
+
+
+void clearEnsembleSums(EnsembleSums& sums, int size) {
+	sums.realizations = 0;
+	sums.sumLnG.assign(size, 0.0);
+	sums.sumLnG2.assign(size, 0.0);
+	sums.sumAbsG2.assign(size, 0.0);
+}
+
+
+void addRealization(EnsembleSums& sums, const CDVector& line) {
+	for (int r=0; r<line.size(); ++r) {
+		double absG = std::abs(line(r));
+		double lnG = std::log(absG);
+		sums.sumLnG[r] += lnG;
+		sums.sumLnG2[r] += lnG*lnG;
+		sums.sumAbsG2[r] += absG*absG;
+	}
+	sums.realizations += 1;
+}
+
+
+void ensembleAverages(const EnsembleSums& sums, std::vector<double>& meanLnG,
+		              std::vector<double>& errorLnG, std::vector<double>& meanAbsG2) {
+	int N = sums.realizations;
+	int size = sums.sumLnG.size();
+	meanLnG.assign(size, 0.0);
+	errorLnG.assign(size, 0.0);
+	meanAbsG2.assign(size, 0.0);
+	if (N==0) return;
+	for (int r=0; r<size; ++r) {
+		meanLnG[r] = sums.sumLnG[r]/N;
+		meanAbsG2[r] = sums.sumAbsG2[r]/N;
+		if (N>1) {
+			double variance = (sums.sumLnG2[r] - N*meanLnG[r]*meanLnG[r])/(N-1);
+			errorLnG[r] = std::sqrt(std::max(variance, 0.0)/N);
+		}
+	}
+}
+
+
+double fitInverseLocalizationLength(const std::vector<double>& meanLnG,
+		                            int rMin, int rMax) {
+	rMax = min(rMax, (int) meanLnG.size()-1);
+	if (rMax-rMin < 1) {
+		std::cout << "At least two points are needed for the fit" << std::endl;
+		exit(-1);
+	}
+	double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+	int num = rMax - rMin + 1;
+	for (int r=rMin; r<=rMax; ++r) {
+		sx += r;
+		sy += meanLnG[r];
+		sxx += double(r)*r;
+		sxy += r*meanLnG[r];
+	}
+	double slope = (num*sxy - sx*sy)/(num*sxx - sx*sx);
+	return -slope;
+}
+
+
+std::string ensembleParameters(const EnsembleData& ensembleData) {
+	const InteractionData& data = ensembleData.interactionData;
+	std::ostringstream out;
+	out << std::setprecision(17) << std::boolalpha;
+	out << "xmax=" << ensembleData.xmax
+		<< " initialSite=" << ensembleData.initialSite
+		<< " separation=" << ensembleData.separation
+		<< " z=" << ensembleData.z.real() << "," << ensembleData.z.imag()
+		<< " seed=" << data.seed
+		<< " onsiteE=" << data.onsiteE
+		<< " hop=" << data.hop
+		<< " dyn=" << data.dyn
+		<< " randomOnsite=" << data.randomOnSite
+		<< " randomHop=" << data.randomHop
+		<< " randomDyn=" << data.randomDyn
+		<< " maxDistance=" << data.maxDistance
+		<< " longRangeHop=" << data.longRangeHop
+		<< " longRangeDyn=" << data.longRangeDyn;
+	return out.str();
+}
+
+
+void saveEnsembleCheckpoint(std::string filename, std::string parameters,
+		                    const EnsembleSums& sums) {
+	// write to a temporary file first so that a crash never leaves half a checkpoint
+	std::string temporary = filename + ".tmp";
+	std::ofstream out(temporary.c_str());
+	out << std::setprecision(17);
+	out << "ensembleCheckpoint " << sums.realizations << " "
+		<< sums.sumLnG.size() << "\n";
+	out << parameters << "\n";
+	for (int r=0; r<sums.sumLnG.size(); ++r) {
+		out << r << "\t" << sums.sumLnG[r] << "\t" << sums.sumLnG2[r]
+			<< "\t" << sums.sumAbsG2[r] << "\n";
+	}
+	out.close();
+	rename(temporary.c_str(), filename.c_str());
+}
+
+
+bool loadEnsembleCheckpoint(std::string filename, std::string& parameters,
+		                    EnsembleSums& sums) {
+	std::ifstream in(filename.c_str());
+	if (!in) return false;
+	std::string tag;
+	int realizations, size;
+	if (!(in >> tag >> realizations >> size) || tag!="ensembleCheckpoint") {
+		return false;
+	}
+	in >> std::ws;
+	if (!std::getline(in, parameters)) return false;
+	clearEnsembleSums(sums, size);
+	for (int i=0; i<size; ++i) {
+		int r;
+		if (!(in >> r >> sums.sumLnG[i] >> sums.sumLnG2[i] >> sums.sumAbsG2[i])) {
+			return false;
+		}
+	}
+	sums.realizations = realizations;
+	return true;
+}
+
+
+static bool writeAll(int fd, const char* buffer, size_t size) {
+	while (size > 0) {
+		ssize_t written = write(fd, buffer, size);
+		if (written <= 0) return false;
+		buffer += written;
+		size -= written;
+	}
+	return true;
+}
+
+
+static bool readAll(int fd, char* buffer, size_t size) {
+	while (size > 0) {
+		ssize_t got = read(fd, buffer, size);
+		if (got <= 0) return false;
+		buffer += got;
+		size -= got;
+	}
+	return true;
+}
+
+
+/**
+ * the worker process: calculate the realizations first, first+step, ... in
+ * its own scratch directory and send the lines through the pipe
+ */
+static void ensembleWorker(EnsembleData& ensembleData, int first, int step,
+		                   int worker, int fd) {
+	// the pid keeps apart the workers of runs sharing the directory
+	std::string scratch = ".ensemble_" + itos(worker) + "_" + itos(getpid());
+	mkdir(scratch.c_str(), 0755);
+	if (chdir(scratch.c_str()) != 0) {
+		std::cout << "Cannot use the scratch directory " << scratch << std::endl;
+		_exit(1);
+	}
+
+	LatticeShape lattice(1);
+	lattice.setXmax(ensembleData.xmax);
+	// the index matrices only depend on the lattice
+	generateIndexMatrix(lattice);
+
+	InteractionData interactionData = ensembleData.interactionData;
+	for (int k=first; k<ensembleData.numRealizations; k+=step) {
+		interactionData.seed = ensembleData.interactionData.seed + k;
+		CDVector line;
+		greenFuncLine(lattice, interactionData, ensembleData.initialSite,
+				ensembleData.separation, ensembleData.z, line);
+		if (!writeAll(fd, (const char*) line.data(), line.size()*sizeof(dcomplex))) {
+			_exit(1);
+		}
+	}
+	close(fd);
+
+	if (chdir("..") == 0) {
+		rmdir(scratch.c_str());
+	}
+	_exit(0);
+}
+
+
+void runEnsemble(EnsembleData& ensembleData, EnsembleSums& sums) {
+	int size = ensembleData.xmax - ensembleData.separation
+			   - ensembleData.initialSite + 1;
+	if (size < 1) {
+		std::cout << "No site m with m + separation <= xmax" << std::endl;
+		exit(-1);
+	}
+
+	clearEnsembleSums(sums, size);
+	std::string parameters = ensembleParameters(ensembleData);
+	std::string checkpointParameters;
+	if (ensembleData.resume && loadEnsembleCheckpoint(ensembleData.checkpointFile,
+			                                          checkpointParameters, sums)) {
+		if (checkpointParameters != parameters || sums.sumLnG.size() != size) {
+			std::cout << ensembleData.checkpointFile
+					  << " belongs to a run with different parameters:\n  "
+					  << checkpointParameters << "\ninstead of\n  " << parameters
+					  << std::endl;
+			exit(-1);
+		}
+		std::cout << "Resume after " << sums.realizations << " realizations"
+				  << std::endl;
+	}
+
+	int done = sums.realizations;
+	int remaining = ensembleData.numRealizations - done;
+	if (remaining <= 0) return;
+	int workers = min(ensembleData.workers, remaining);
+
+	std::vector<int> pipes(workers);
+	std::vector<pid_t> pids(workers);
+	for (int w=0; w<workers; ++w) {
+		int fds[2];
+		if (pipe(fds) != 0) {
+			std::cout << "Cannot create a pipe for worker " << w << std::endl;
+			exit(-1);
+		}
+		std::cout.flush();
+		fflush(stdout);
+		pids[w] = fork();
+		if (pids[w] < 0) {
+			std::cout << "Cannot fork worker " << w << std::endl;
+			exit(-1);
+		}
+		if (pids[w] == 0) {
+			close(fds[0]);
+			// the read ends of the workers forked before belong to the parent
+			for (int v=0; v<w; ++v) close(pipes[v]);
+			ensembleWorker(ensembleData, done+w, workers, w, fds[1]);
+		}
+		close(fds[1]);
+		pipes[w] = fds[0];
+	}
+
+	/*
+	 * realization k comes from worker (k-done)%workers, so reading the pipes
+	 * in turn accumulates the realizations in the order of the seeds
+	 */
+	CDVector line(size);
+	bool failed = false;
+	for (int k=done; k<ensembleData.numRealizations; ++k) {
+		int w = (k-done)%workers;
+		if (!readAll(pipes[w], (char*) line.data(), size*sizeof(dcomplex))) {
+			std::cout << "Worker " << w << " failed at realization " << k << std::endl;
+			failed = true;
+			break;
+		}
+		addRealization(sums, line);
+		if (ensembleData.checkpointInterval > 0
+				&& sums.realizations%ensembleData.checkpointInterval == 0) {
+			saveEnsembleCheckpoint(ensembleData.checkpointFile, parameters, sums);
+		}
+	}
+
+	for (int w=0; w<workers; ++w) {
+		close(pipes[w]);
+		int status;
+		waitpid(pids[w], &status, 0);
+	}
+	if (failed) {
+		// the checkpoint keeps the realizations done so far
+		if (ensembleData.checkpointInterval > 0) {
+			saveEnsembleCheckpoint(ensembleData.checkpointFile, parameters, sums);
+		}
+		exit(-1);
+	}
+	if (ensembleData.checkpointInterval > 0) {
+		saveEnsembleCheckpoint(ensembleData.checkpointFile, parameters, sums);
+	}
+}
+
+
+void saveEnsembleAverages(std::string filename, const EnsembleSums& sums) {
+	std::vector<double> meanLnG, errorLnG, meanAbsG2;
+	ensembleAverages(sums, meanLnG, errorLnG, meanAbsG2);
+	std::ofstream out(filename.c_str());
+	out << std::setprecision(15);
+	for (int r=0; r<meanLnG.size(); ++r) {
+		out << r << "\t" << meanLnG[r] << "\t" << errorLnG[r] << "\t"
+			<< meanAbsG2[r] << "\n";
+	}
+	out.close();
+}
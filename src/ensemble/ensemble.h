@@ -0,0 +1,110 @@
+/*
+ * ensemble.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Average over many realizations of the disorder
+ *
+ * 1/two_particle_localization_length
+ * = - lim_{|n-m|--> infty} << ln|<m, m+a|G(z)|n, n+a>| >> / |n-m|
+ *
+ * For every realization (seed = interactionData.seed + k, k = 0, 1, ...) the
+ * line G(m, m+a; n, n+a), m = n, n+1, ..., xmax-a is calculated and the sums
+ * of ln|G|, (ln|G|)^2 and |G|^2 are accumulated for every r = m - n.
+ *
+ * The realizations run in "workers" forked processes (the engines keep their
+ * state in global variables), but the sums are always accumulated in the
+ * order of the seeds, so the result does not depend on the number of workers.
+ */
+
+#ifndef ENSEMBLE_H_
+#define ENSEMBLE_H_
+
+#include <string>
+#include <vector>
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../basis_set/basis.h"
+#include "../formMatrix/formMatrix.h"
+
+
+typedef struct {
+	int xmax;
+	InteractionData interactionData; // seed is the seed of the first realization
+	int initialSite; // n
+	int separation; // a
+	dcomplex z;
+	int numRealizations;
+	int workers;
+	// save the partial sums every checkpointInterval realizations (0: never)
+	int checkpointInterval;
+	std::string checkpointFile;
+	// continue from checkpointFile if it exists
+	bool resume;
+} EnsembleData;
+
+
+typedef struct {
+	int realizations; // the number of realizations in the sums
+	std::vector<double> sumLnG; // indexed by r = m - n
+	std::vector<double> sumLnG2;
+	std::vector<double> sumAbsG2;
+} EnsembleSums;
+
+
+/**
+ * G(n+r, n+r+a; n, n+a) for r = 0, 1, ..., xmax-a-n of one realization
+ *
+ * generateIndexMatrix(lattice) must have been called; the interactions are
+ * set up from interactionData
+ */
+void greenFuncLine(LatticeShape& lattice, InteractionData& interactionData,
+		           int n, int a, dcomplex z, CDVector& line);
+
+void clearEnsembleSums(EnsembleSums& sums, int size);
+
+void addRealization(EnsembleSums& sums, const CDVector& line);
+
+/**
+ * <<ln|G|>>, its standard error and <<|G|^2>> as functions of r
+ */
+void ensembleAverages(const EnsembleSums& sums, std::vector<double>& meanLnG,
+		              std::vector<double>& errorLnG, std::vector<double>& meanAbsG2);
+
+/**
+ * least-squares slope of <<ln|G|>> against r for rMin <= r <= rMax; the
+ * inverse localization length is minus the slope
+ */
+double fitInverseLocalizationLength(const std::vector<double>& meanLnG,
+		                            int rMin, int rMax);
+
+/**
+ * the parameters that the realizations depend on (everything but
+ * numRealizations, workers and the checkpoint settings) in one line; a run
+ * only resumes from a checkpoint with the same parameters
+ */
+std::string ensembleParameters(const EnsembleData& ensembleData);
+
+void saveEnsembleCheckpoint(std::string filename, std::string parameters,
+		                    const EnsembleSums& sums);
+
+/**
+ * return false if the file does not exist or is not a checkpoint
+ */
+bool loadEnsembleCheckpoint(std::string filename, std::string& parameters,
+		                    EnsembleSums& sums);
+
+/**
+ * run the realizations that are not in sums yet (all of them unless the
+ * run resumes from a checkpoint) and accumulate them; the run stops if the
+ * checkpoint to resume from has different parameters
+ */
+void runEnsemble(EnsembleData& ensembleData, EnsembleSums& sums);
+
+/**
+ * r, <<ln|G|>>, standard error of <<ln|G|>>, <<|G|^2>> in four columns
+ */
+void saveEnsembleAverages(std::string filename, const EnsembleSums& sums);
+
+#endif /* ENSEMBLE_H_ */
@@ -0,0 +1,125 @@
+/*
+ * ensemble_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "ensemble.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+
+
+static EnsembleData smallEnsemble() {
+	EnsembleData ensembleData;
+	ensembleData.xmax = 21;
+	InteractionData interactionData = { 2.5, 1.0, 1.0,
+			                            true, false, false,
+			                            2, 100,
+			                            true, true};
+	ensembleData.interactionData = interactionData;
+	ensembleData.initialSite = 10;
+	ensembleData.separation = 1;
+	ensembleData.z = dcomplex(0.5, 0.01);
+	ensembleData.numRealizations = 7;
+	ensembleData.workers = 1;
+	ensembleData.checkpointInterval = 0;
+	ensembleData.checkpointFile = "ensemble_test.chk";
+	ensembleData.resume = false;
+	return ensembleData;
+}
+
+
+TEST(EnsembleTest, IndependentOfWorkers) {
+	EnsembleData ensembleData = smallEnsemble();
+	EnsembleSums serial;
+	runEnsemble(ensembleData, serial);
+	ASSERT_EQ(serial.realizations, 7);
+	ASSERT_EQ(serial.sumLnG.size(), 11);
+
+	// the same sums from a plain loop over the seeds
+	LatticeShape lattice(1);
+	lattice.setXmax(ensembleData.xmax);
+	generateIndexMatrix(lattice);
+	EnsembleSums reference;
+	clearEnsembleSums(reference, 11);
+	InteractionData interactionData = ensembleData.interactionData;
+	for (int k=0; k<7; ++k) {
+		interactionData.seed = ensembleData.interactionData.seed + k;
+		CDVector line;
+		greenFuncLine(lattice, interactionData, 10, 1, ensembleData.z, line);
+		addRealization(reference, line);
+	}
+
+	ensembleData.workers = 3;
+	EnsembleSums parallel;
+	runEnsemble(ensembleData, parallel);
+	for (int r=0; r<11; ++r) {
+		EXPECT_EQ(serial.sumLnG[r], parallel.sumLnG[r]);
+		EXPECT_EQ(serial.sumAbsG2[r], parallel.sumAbsG2[r]);
+		EXPECT_EQ(serial.sumLnG[r], reference.sumLnG[r]);
+	}
+}
+
+
+TEST(EnsembleTest, ResumeFromCheckpoint) {
+	EnsembleData ensembleData = smallEnsemble();
+	EnsembleSums all;
+	runEnsemble(ensembleData, all);
+
+	// stop after 4 realizations, then resume with 2 workers
+	ensembleData.numRealizations = 4;
+	ensembleData.checkpointInterval = 2;
+	EnsembleSums partial;
+	runEnsemble(ensembleData, partial);
+
+	ensembleData.numRealizations = 7;
+	ensembleData.workers = 2;
+	ensembleData.resume = true;
+	EnsembleSums resumed;
+	runEnsemble(ensembleData, resumed);
+
+	// the checkpoint cannot be resumed with another energy or seed
+	std::string parameters;
+	EnsembleSums saved;
+	ASSERT_TRUE(loadEnsembleCheckpoint("ensemble_test.chk", parameters, saved));
+	EXPECT_EQ(parameters, ensembleParameters(ensembleData));
+	EnsembleData otherEnergy = ensembleData;
+	otherEnergy.z = dcomplex(0.6, 0.01);
+	EnsembleSums refused;
+	EXPECT_EXIT(runEnsemble(otherEnergy, refused), ::testing::ExitedWithCode(255),
+			    "");
+	EnsembleData otherSeed = ensembleData;
+	otherSeed.interactionData.seed += 1;
+	EXPECT_NE(ensembleParameters(otherSeed), parameters);
+	remove("ensemble_test.chk");
+
+	ASSERT_EQ(resumed.realizations, 7);
+	for (int r=0; r<11; ++r) {
+		EXPECT_NEAR(resumed.sumLnG[r], all.sumLnG[r], 1e-12*std::abs(all.sumLnG[r]));
+		EXPECT_NEAR(resumed.sumAbsG2[r], all.sumAbsG2[r], 1e-12*all.sumAbsG2[r]);
+	}
+}
+
+
+TEST(EnsembleTest, FitSlope) {
+	std::vector<double> meanLnG;
+	for (int r=0; r<20; ++r) {
+		meanLnG.push_back(-0.25*r + 1.0);
+	}
+	EXPECT_NEAR(fitInverseLocalizationLength(meanLnG, 2, 15), 0.25, 1e-12);
+
+	EnsembleSums sums;
+	clearEnsembleSums(sums, 2);
+	CDVector line(2);
+	line << dcomplex(1.0, 0.0), dcomplex(0.0, std::exp(-1.0));
+	addRealization(sums, line);
+	line << dcomplex(std::exp(-2.0), 0.0), dcomplex(0.0, std::exp(-3.0));
+	addRealization(sums, line);
+	std::vector<double> meanLnG2, errorLnG, meanAbsG2;
+	ensembleAverages(sums, meanLnG2, errorLnG, meanAbsG2);
+	EXPECT_NEAR(meanLnG2[0], -1.0, 1e-12);
+	EXPECT_NEAR(meanLnG2[1], -2.0, 1e-12);
+	EXPECT_NEAR(errorLnG[0], 1.0, 1e-12);
+	EXPECT_NEAR(meanAbsG2[0], 0.5*(1.0+std::exp(-4.0)), 1e-12);
+}
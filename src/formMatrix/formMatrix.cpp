@@ -6,6 +6,7 @@
  */
 
 #include "formMatrix.h"
+#include "../Utility/blockMemory.h"
 
 // the following three functions are defined for testing purposes
 double tMatrix(Interaction& interaction, int i, int j) {
@@ -121,7 +122,6 @@ void formMatrixZ(int K, dcomplex Energy, CDMatrix& ZK) {
  */
 void formMatrixM(int K, int Kp, CDMatrix& MKKp) {
 	extern std::vector< std::vector< Basis > > VtoG;
-	extern IMatrix IndexMatrix;
 
 	int distance = Kp - K;
 
@@ -136,7 +136,7 @@ void formMatrixM(int K, int Kp, CDMatrix& MKKp) {
 		// obtain the site index corresponding to basis1
 		getLatticeIndex(*pLattice, basis1, site1, site2);
 		// find out the index for the basis1 in the corresponding vector V_K
-		int row = IndexMatrix(site1, site2);
+		int row = getIndexInV(site1, site2);
 
 		generateNeighbors( basis1, distance, *pLattice, neighbors);
 
@@ -144,7 +144,9 @@ void formMatrixM(int K, int Kp, CDMatrix& MKKp) {
 			Basis basis2 = neighbors[j];
 			getLatticeIndex(*pLattice, basis2, site1, site2);
 
-			int col = IndexMatrix(site1, site2);
+			int col = getIndexInV(site1, site2);
+			// the neighbor is outside a truncated basis
+			if (col < 0) continue;
 
 			MKKp(row, col) = pInteraction->hop(basis1, basis2);
 
@@ -198,12 +200,11 @@ void formMatrixM(int K, int Kp, CDMatrix& MKKp) {
  * In this case, K+p-1 = Kmax and p = Kmax-K + 1 (which is numBlock in each row
  * or column)
  */
-void formMatrixW(int K, dcomplex energy, CDMatrix& WK) {
+void getWSize(int K, int& total_rows, int& total_cols) {
 	extern Interaction *pInteraction;
 	int maxDistance = pInteraction->getMaxDistance();
-	// find out the size of WK matrix
-	int total_rows=0;
-	int total_cols=0;
+	total_rows=0;
+	total_cols=0;
 	// go through the blocks that on the diagonal
 	// it may happen that the number of blocks is < maxDistance
 	extern std::vector<int> DimsOfV;
@@ -215,9 +216,21 @@ void formMatrixW(int K, dcomplex energy, CDMatrix& WK) {
 		total_rows += rows;
 		total_cols += cols;
 	}
+}
 
-	//assign memory for WK
-	WK = CDMatrix::Zero(total_rows, total_cols);
+
+/**
+ * fill WK, which already has the size given by getWSize
+ */
+template <typename Matrix>
+static void fillMatrixW(int K, dcomplex energy, Matrix& WK) {
+	PROFILE_SCOPE("formMatrixW");
+	extern Interaction *pInteraction;
+	int maxDistance = pInteraction->getMaxDistance();
+	extern std::vector<int> DimsOfV;
+	int Kmax = DimsOfV.size()-1;
+	int numBlock = min(Kmax-K+1, maxDistance); //the number of blocks
+	WK.setZero();
 
 	int row_start = 0;
 	int col_start = 0;
@@ -252,6 +265,20 @@ void formMatrixW(int K, dcomplex energy, CDMatrix& WK) {
          */
 		row_start += row_size;
 	}
+	PROFILE_MATRIX("W", K, WK);
+}
+
+
+void formMatrixW(int K, dcomplex energy, CDMatrix& WK) {
+	int rows, cols;
+	getWSize(K, rows, cols);
+	allocateMatrix(WK, rows, cols);
+	fillMatrixW(K, energy, WK);
+}
+
+
+void formMatrixW(int K, dcomplex energy, CDMatrixMap& WK) {
+	fillMatrixW(K, energy, WK);
 }
 
 
@@ -318,12 +345,11 @@ void formMatrixW(int K, dcomplex energy, CDMatrix& WK) {
  * then numBlockInCol = Kmax - K + 1. So numBlockInCol = min(Kmax - K + 1, p).
  *
  */
-void formMatrixAlpha(int K, CDMatrix& AlphaK) {
+void getAlphaSize(int K, int& total_rows, int& total_cols) {
 	extern Interaction *pInteraction;
 	int maxDistance = pInteraction->getMaxDistance();
-	// find out the size of alpha matrix
-	int total_rows=0;
-	int total_cols=0;
+	total_rows=0;
+	total_cols=0;
 
 	// it may happen that the number of blocks is < maxDistance
 	extern std::vector<int> DimsOfV;
@@ -348,9 +374,24 @@ void formMatrixAlpha(int K, CDMatrix& AlphaK) {
 		getMSize(K, Kstart+i, rows, cols);
 		total_cols += cols;
 	}
+}
 
-	//assign memory for AlphaK
-	AlphaK = CDMatrix::Zero(total_rows, total_cols);
+
+/**
+ * fill AlphaK, which already has the size given by getAlphaSize
+ */
+template <typename Matrix>
+static void fillMatrixAlpha(int K, Matrix& AlphaK) {
+	PROFILE_SCOPE("formMatrixAlpha");
+	extern Interaction *pInteraction;
+	int maxDistance = pInteraction->getMaxDistance();
+	extern std::vector<int> DimsOfV;
+	int Kmin = 1;
+	int Kmax = DimsOfV.size()-1;
+	int numBlockInCol = min(Kmax-K+1, maxDistance);
+	int numBlockInRow = min(K-Kmin, maxDistance);
+	int Kstart = max(Kmin, K-maxDistance);
+	AlphaK.setZero();
 
 	int row_start = 0;
 	int col_start = 0;
@@ -382,6 +423,19 @@ void formMatrixAlpha(int K, CDMatrix& AlphaK) {
 }
 
 
+void formMatrixAlpha(int K, CDMatrix& AlphaK) {
+	int rows, cols;
+	getAlphaSize(K, rows, cols);
+	allocateMatrix(AlphaK, rows, cols);
+	fillMatrixAlpha(K, AlphaK);
+}
+
+
+void formMatrixAlpha(int K, CDMatrixMap& AlphaK) {
+	fillMatrixAlpha(K, AlphaK);
+}
+
+
 
 /**
  * Form the Beta matrix
@@ -445,12 +499,11 @@ void formMatrixAlpha(int K, CDMatrix& AlphaK) {
  * Therefore numBlockInCol = p in the code.
  *
  */
-void formMatrixBeta(int K, CDMatrix& BetaK) {
+void getBetaSize(int K, int& total_rows, int& total_cols) {
 	extern Interaction *pInteraction;
 	int maxDistance = pInteraction->getMaxDistance();
-	// find out the size of beta matrix
-	int total_rows=0;
-	int total_cols=0;
+	total_rows=0;
+	total_cols=0;
 
 	extern std::vector<int> DimsOfV;
 	int Kmax = DimsOfV.size()-1;
@@ -475,10 +528,22 @@ void formMatrixBeta(int K, CDMatrix& BetaK) {
 		getMSize(K+maxDistance-1, K+maxDistance+i, rows, cols);
 		total_cols += cols;
 	}
+}
 
 
-	//assign memory for BetaK
-	BetaK = CDMatrix::Zero(total_rows, total_cols);
+/**
+ * fill BetaK, which already has the size given by getBetaSize
+ */
+template <typename Matrix>
+static void fillMatrixBeta(int K, Matrix& BetaK) {
+	PROFILE_SCOPE("formMatrixBeta");
+	extern Interaction *pInteraction;
+	int maxDistance = pInteraction->getMaxDistance();
+	extern std::vector<int> DimsOfV;
+	int Kmax = DimsOfV.size()-1;
+	int numBlockInCol = maxDistance;
+	int numBlockInRow = min(Kmax-(K+maxDistance)+1, maxDistance);
+	BetaK.setZero();
 
 	int row_start = 0;
 	int col_start = 0;
@@ -502,3 +567,16 @@ void formMatrixBeta(int K, CDMatrix& BetaK) {
 		row_start += row_size;
 	} // end of outer for loop
 }
+
+
+void formMatrixBeta(int K, CDMatrix& BetaK) {
+	int rows, cols;
+	getBetaSize(K, rows, cols);
+	allocateMatrix(BetaK, rows, cols);
+	fillMatrixBeta(K, BetaK);
+}
+
+
+void formMatrixBeta(int K, CDMatrixMap& BetaK) {
+	fillMatrixBeta(K, BetaK);
+}
@@ -11,6 +11,7 @@
 #include "../basis_set/basis.h"
 #include "../Utility/misc.h"
 #include "../Utility/random_generator.h"
+#include "../Utility/profiler.h"
 #include "../IO/binaryIO.h"
 
 /* this InteractionData struct contains no information about the size of the lattice*/
@@ -307,4 +308,23 @@ void formMatrixAlpha(int K, CDMatrix& AlphaK);
 
 void formMatrixBeta(int K, CDMatrix& BetaK);
 
+/**
+ * the sizes of W_K, alpha_K and beta_K
+ */
+void getWSize(int K, int& rows, int& cols);
+
+void getAlphaSize(int K, int& rows, int& cols);
+
+void getBetaSize(int K, int& rows, int& cols);
+
+/**
+ * the same into storage that the caller keeps: the map must already have the
+ * size given by getWSize (getAlphaSize, getBetaSize)
+ */
+void formMatrixW(int K, dcomplex energy, CDMatrixMap& WK);
+
+void formMatrixAlpha(int K, CDMatrixMap& AlphaK);
+
+void formMatrixBeta(int K, CDMatrixMap& BetaK);
+
 #endif /* FORMMATRIX_H_ */
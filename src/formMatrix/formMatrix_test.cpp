@@ -415,3 +415,40 @@ TEST(FormMatrixBeta, RunningOK) {
 
 }
 
+
+
+TEST(FormMatrixMap, SameAsMatrix) {
+	LatticeShape lattice1D(1);
+	int xmax = 30;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	generateIndexMatrix(lattice1D);
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,true,3,230,true,true};
+	setLatticeAndInteractions(lattice1D, interactionData);
+	dcomplex energy = dcomplex(0.5, 0.01);
+
+	// a buffer of garbage larger than every block, formed into at every K
+	CDVector buffer = CDVector::Random(100*100);
+	for (int K=1; K<=2*xmax-1-3; ++K) {
+		CDMatrix W, beta;
+		formMatrixW(K, energy, W);
+		formMatrixBeta(K, beta);
+
+		int rows, cols;
+		getWSize(K, rows, cols);
+		CDMatrixMap WMap(buffer.data(), rows, cols);
+		formMatrixW(K, energy, WMap);
+		EXPECT_TRUE(WMap == W);
+		if (K > 1) {
+			CDMatrix alpha;
+			formMatrixAlpha(K, alpha);
+			getAlphaSize(K, rows, cols);
+			CDMatrixMap alphaMap(buffer.data(), rows, cols);
+			formMatrixAlpha(K, alphaMap);
+			EXPECT_TRUE(alphaMap == alpha);
+		}
+		getBetaSize(K, rows, cols);
+		CDMatrixMap betaMap(buffer.data(), rows, cols);
+		formMatrixBeta(K, betaMap);
+		EXPECT_TRUE(betaMap == beta);
+	}
+}
@@ -0,0 +1,177 @@
+/*
+ * freeParticle.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "freeParticle.h"
+
+
+bool isNoninteracting(const InteractionData& interactionData) {
+	bool nearestNeighborHop = !interactionData.longRangeHop
+			                  || interactionData.maxDistance == 1;
+	return interactionData.dyn == 0.0 && nearestNeighborHop;
+}
+
+
+void singleParticleStates(LatticeShape& lattice, DVector& energies, DMatrix& states) {
+	extern Interaction *pInteraction;
+	int nsite = lattice.getXmax() + 1;
+	DMatrix h = DMatrix::Zero(nsite, nsite);
+	for (int i=0; i<nsite; ++i) {
+		h(i, i) = eVector(*pInteraction, i);
+		for (int j=0; j<nsite; ++j) {
+			if (j!=i) h(i, j) = tMatrix(*pInteraction, i, j);
+		}
+	}
+	Eigen::SelfAdjointEigenSolver<DMatrix> eigensolver(h);
+	if (eigensolver.info() != Eigen::Success) {
+		std::cout << "Failed to diagonalize the single-particle Hamiltonian" << std::endl;
+		exit(-1);
+	}
+	energies = eigensolver.eigenvalues();
+	states = eigensolver.eigenvectors();
+}
+
+
+void pairDenominator(dcomplex z, const DVector& energies, CDMatrix& oneOverDenominator) {
+	int n = energies.size();
+	oneOverDenominator.resize(n, n);
+	for (int b=0; b<n; ++b) {
+		for (int a=0; a<n; ++a) {
+			oneOverDenominator(a, b) = 1.0/(z - energies(a) - energies(b));
+		}
+	}
+}
+
+
+void pairStates(const DMatrix& states, Basis& sites, DMatrix& psi) {
+	DVector phi1 = states.row(sites[0]).transpose();
+	DVector phi2 = states.row(sites[1]).transpose();
+	psi = phi1*phi2.transpose() - phi2*phi1.transpose();
+}
+
+
+void greenFunc_free(LatticeShape& lattice, Basis& bra, Basis& ket,
+		            std::vector<dcomplex>& zList, std::vector<dcomplex>& gfList) {
+	DVector energies;
+	DMatrix states;
+	singleParticleStates(lattice, energies, states);
+
+	/**
+	 * sum_{a<b} Psi_ab(x)*Psi_ab(y) = sum_{a,b} phi_a(x1)*phi_b(x2)*Psi_ab(y)
+	 * since Psi_ab(y) = -Psi_ba(y)
+	 */
+	DMatrix psiKet;
+	pairStates(states, ket, psiKet);
+	DVector phi1 = states.row(bra[0]).transpose();
+	DVector phi2 = states.row(bra[1]).transpose();
+	DMatrix numerator = (phi1*phi2.transpose()).cwiseProduct(psiKet);
+
+	gfList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		CDMatrix oneOverDenominator;
+		pairDenominator(zList[i], energies, oneOverDenominator);
+		dcomplex gf = numerator.cast<dcomplex>().cwiseProduct(oneOverDenominator).sum();
+		gfList.push_back(gf);
+	}
+}
+
+
+void densityOfState_free(LatticeShape& lattice, Basis& basis,
+		                 std::vector<dcomplex>& zList, std::vector<double>& dosList) {
+	std::vector<dcomplex> gfList;
+	greenFunc_free(lattice, basis, basis, zList, gfList);
+	dosList.clear();
+	for (int i=0; i<gfList.size(); ++i) {
+		dosList.push_back(-gfList[i].imag()/M_PI);
+	}
+}
+
+
+void calculateAllGreenFunc_free(LatticeShape& lattice, Basis& initialSites,
+		                        std::vector<dcomplex>& zList,
+		                        std::vector<std::string>& fileList) {
+	DVector energies;
+	DMatrix states;
+	singleParticleStates(lattice, energies, states);
+	DMatrix psiKet;
+	pairStates(states, initialSites, psiKet);
+	CDMatrix phi = states.cast<dcomplex>();
+
+	for (int i=0; i<zList.size(); ++i) {
+		// G(x1, x2) = sum_{a,b} phi_a(x1)*[Psi_ab(y)/(z-e_a-e_b)]*phi_b(x2)
+		CDMatrix oneOverDenominator;
+		pairDenominator(zList[i], energies, oneOverDenominator);
+		CDMatrix C = psiKet.cast<dcomplex>().cwiseProduct(oneOverDenominator);
+		CDMatrix gf = phi*C*phi.transpose();
+
+		// the same layout as the other engines: symmetric with a zero diagonal
+		for (int n1=0; n1<gf.rows(); ++n1) {
+			gf(n1, n1) = dcomplex(0, 0);
+			for (int n2=n1+1; n2<gf.cols(); ++n2) {
+				gf(n2, n1) = gf(n1, n2);
+			}
+		}
+		saveMatrix(fileList[i], gf);
+	}
+}
+
+
+void densityOfStateAll_free(LatticeShape& lattice, std::vector<dcomplex>& zList,
+		                    std::vector<std::string>& fileList) {
+	DVector energies;
+	DMatrix states;
+	singleParticleStates(lattice, energies, states);
+	int nsite = states.rows();
+	CDMatrix phi2 = states.cwiseProduct(states).cast<dcomplex>();
+
+	for (int i=0; i<zList.size(); ++i) {
+		CDMatrix oneOverDenominator;
+		pairDenominator(zList[i], energies, oneOverDenominator);
+
+		/**
+		 * G(y; y) = sum_{a,b} [phi_a(y1)^2*phi_b(y2)^2
+		 *                      - phi_a(y1)*phi_a(y2)*phi_b(y1)*phi_b(y2)]/(z-e_a-e_b)
+		 */
+		CDMatrix direct = phi2*oneOverDenominator*phi2.transpose();
+		DMatrix dos = DMatrix::Zero(nsite, nsite);
+		for (int n1=0; n1<nsite; ++n1) {
+			// Q(n2, a) = phi_a(n1)*phi_a(n2)
+			CDMatrix Q = (states*states.row(n1).asDiagonal()).cast<dcomplex>();
+			CDVector exchange = (Q*oneOverDenominator).cwiseProduct(Q).rowwise().sum();
+			for (int n2=n1+1; n2<nsite; ++n2) {
+				double rho = -(direct(n1, n2) - exchange(n2)).imag()/M_PI;
+				dos(n1, n2) = rho;
+				dos(n2, n1) = rho;
+			}
+		}
+		saveMatrixText(fileList[i], dos);
+	}
+}
+
+
+void totalDensityOfState_free(LatticeShape& lattice, const std::vector<double>& EList,
+		                      double eta, std::vector<double>& dosList) {
+	DVector energies;
+	DMatrix states;
+	singleParticleStates(lattice, energies, states);
+	int n = energies.size();
+
+	// the energies of all the pairs a < b
+	DArray pairEnergies(n*(n-1)/2);
+	int k = 0;
+	for (int a=0; a<n; ++a) {
+		for (int b=a+1; b<n; ++b) {
+			pairEnergies(k++) = energies(a) + energies(b);
+		}
+	}
+
+	dosList.clear();
+	for (int i=0; i<EList.size(); ++i) {
+		DArray shifted = pairEnergies - EList[i];
+		double rho = eta*(shifted.square() + eta*eta).inverse().sum()/M_PI;
+		dosList.push_back(rho);
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * freeParticle.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Two particles without dynamic interaction (dyn = 0) from the eigenstates
+ * of a single particle.
+ *
+ * The basis (x1, x2), x1 < x2, excludes double occupation. With hopping
+ * between nearest neighbors only the particles can never pass each other,
+ * so the two-particle Hamiltonian is the same as that of two free fermions
+ * in the antisymmetric states. With the single-particle eigenstates
+ * h*phi_a = e_a*phi_a,
+ *
+ *   G(x1, x2; y1, y2; z) = sum_{a<b} Psi_ab(x1, x2)*Psi_ab(y1, y2)/(z - e_a - e_b)
+ *
+ *   Psi_ab(x1, x2) = phi_a(x1)*phi_b(x2) - phi_b(x1)*phi_a(x2)
+ *
+ * which only needs one (xmax+1) x (xmax+1) diagonalization. With long-range
+ * hopping the particles can pass each other without the fermionic sign, the
+ * constraint x1 != x2 is a real interaction and this does not hold.
+ *
+ * Before calling the functions below, call setUpIndexInteractions(lattice,
+ * interactionData) (or setLatticeAndInteractions) as for the direct engine.
+ */
+
+#ifndef FREEPARTICLE_H_
+#define FREEPARTICLE_H_
+
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../basis_set/basis.h"
+#include "../formMatrix/formMatrix.h"
+#include "../IO/MatrixIO.h"
+#include "../IO/textIO.h"
+
+
+/**
+ * true if G can be obtained from the single-particle states: no dynamic
+ * interaction and hopping between nearest neighbors only
+ */
+bool isNoninteracting(const InteractionData& interactionData);
+
+/**
+ * the eigenvalues and eigenvectors (columns of states) of the single-particle
+ * Hamiltonian h(i,i) = e(i), h(i,j) = t(i,j) of pInteraction
+ */
+void singleParticleStates(LatticeShape& lattice, DVector& energies, DMatrix& states);
+
+/**
+ * 1/(z - e_a - e_b) for all a, b
+ */
+void pairDenominator(dcomplex z, const DVector& energies, CDMatrix& oneOverDenominator);
+
+/**
+ * Psi_ab(y1, y2) = phi_a(y1)*phi_b(y2) - phi_b(y1)*phi_a(y2) for all a, b
+ */
+void pairStates(const DMatrix& states, Basis& sites, DMatrix& psi);
+
+void greenFunc_free(LatticeShape& lattice, Basis& bra, Basis& ket,
+		            std::vector<dcomplex>& zList, std::vector<dcomplex>& gfList);
+
+void densityOfState_free(LatticeShape& lattice, Basis& basis,
+		                 std::vector<dcomplex>& zList, std::vector<double>& dosList);
+
+/**
+ * G(x1, x2; initial_sites) for all x1 < x2 (O(xmax^3) per z); the files
+ * have the same layout as those of calculateAllGreenFunc
+ */
+void calculateAllGreenFunc_free(LatticeShape& lattice, Basis& initialSites,
+		                        std::vector<dcomplex>& zList,
+		                        std::vector<std::string>& fileList);
+
+/**
+ * the density of state at all (x1, x2) in the layout of densityOfStateAll_direct
+ */
+void densityOfStateAll_free(LatticeShape& lattice, std::vector<dcomplex>& zList,
+		                    std::vector<std::string>& fileList);
+
+/**
+ * the total two-particle density of state broadened by a Lorentzian of
+ * width eta, the convolution of the single-particle levels:
+ *
+ *   rho(E) = 1/pi * sum_{a<b} eta/((E - e_a - e_b)^2 + eta^2)
+ */
+void totalDensityOfState_free(LatticeShape& lattice, const std::vector<double>& EList,
+		                      double eta, std::vector<double>& dosList);
+
+#endif /* FREEPARTICLE_H_ */
@@ -0,0 +1,115 @@
+/*
+ * freeParticle_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "freeParticle.h"
+#include "../directCalculation/direct_calculation.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+#include "../IO/binaryIO.h"
+
+
+TEST(FreeParticle, Detection) {
+	InteractionData nearest = {2.0,1.0,0.0,true,true,false,4,3,false,true};
+	EXPECT_TRUE(isNoninteracting(nearest));
+	InteractionData longRange = {2.0,1.0,0.0,true,false,false,4,3,true,true};
+	EXPECT_FALSE(isNoninteracting(longRange));
+	InteractionData interacting = {2.0,1.0,1.0,true,false,false,1,3,false,false};
+	EXPECT_FALSE(isNoninteracting(interacting));
+}
+
+
+TEST(FreeParticle, SameAsDirect) {
+	LatticeShape lattice1D(1);
+	int xmax = 24;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {3.0,1.0,0.0,true,true,false,1,11,false,false};
+	ASSERT_TRUE(isNoninteracting(interactionData));
+	setUpIndexInteractions(lattice1D, interactionData);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.7, 0.05));
+	zList.push_back(dcomplex(-2.0, 0.2));
+	Basis initialSites(10, 11);
+	Basis finalSites(4, 17);
+
+	std::vector<dcomplex> gfDirect, gfFree;
+	greenFunc_direct(lattice1D, finalSites, initialSites, zList, gfDirect);
+	greenFunc_free(lattice1D, finalSites, initialSites, zList, gfFree);
+	for (int i=0; i<zList.size(); ++i) {
+		EXPECT_NEAR(std::abs(gfFree[i] - gfDirect[i]), 0.0, 1e-10*std::abs(gfDirect[i]));
+	}
+
+	// the whole matrix against the recursive engine
+	std::vector<std::string> recursiveFiles, freeFiles;
+	recursiveFiles.push_back("free_test_recursive0.bin");
+	recursiveFiles.push_back("free_test_recursive1.bin");
+	freeFiles.push_back("free_test_free0.bin");
+	freeFiles.push_back("free_test_free1.bin");
+	calculateAllGreenFunc(lattice1D, initialSites, interactionData, zList, recursiveFiles);
+	calculateAllGreenFunc_free(lattice1D, initialSites, zList, freeFiles);
+	for (int i=0; i<zList.size(); ++i) {
+		CDMatrix gfRecursive, gfAll;
+		loadMatrixBin(recursiveFiles[i], gfRecursive);
+		loadMatrixBin(freeFiles[i], gfAll);
+		remove(recursiveFiles[i].c_str());
+		remove(freeFiles[i].c_str());
+		EXPECT_LT((gfAll - gfRecursive).norm(), 1e-10*gfRecursive.norm());
+	}
+
+	// the density of state at all sites against the direct engine
+	std::vector<std::string> directDos, freeDos;
+	directDos.push_back("free_test_dos_direct.txt");
+	freeDos.push_back("free_test_dos_free.txt");
+	std::vector<dcomplex> z0(1, zList[0]);
+	densityOfStateAll_direct(lattice1D, z0, directDos);
+	densityOfStateAll_free(lattice1D, z0, freeDos);
+	DMatrix dosDirect, dosFree;
+	loadMatrixText(directDos[0], dosDirect);
+	loadMatrixText(freeDos[0], dosFree);
+	remove(directDos[0].c_str());
+	remove(freeDos[0].c_str());
+	for (int n1=0; n1<=xmax-1; ++n1) {
+		for (int n2=n1+1; n2<=xmax; ++n2) {
+			// the direct engine leaves the pairs next to the boundaries out
+			if (n1+n2>10 && n1+n2<xmax+xmax-1-10) {
+				EXPECT_NEAR(dosFree(n1, n2), dosDirect(n1, n2), 1e-8);
+			}
+		}
+	}
+}
+
+
+TEST(FreeParticle, TotalDensityOfState) {
+	LatticeShape lattice1D(1);
+	int xmax = 15;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {3.0,1.0,0.0,true,false,false,1,5,false,false};
+	setUpIndexInteractions(lattice1D, interactionData);
+
+	// the two-particle levels from the direct diagonalization
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	formAllBasisSets(lattice1D, basisIndex, basisSets);
+	DMatrix hamiltonian;
+	formHamiltonianMatrix(lattice1D, hamiltonian, basisIndex, basisSets);
+	DVector eigenValues;
+	DMatrix eigenVectors;
+	obtainEigenVectors(hamiltonian, eigenValues, eigenVectors);
+
+	double eta = 0.1;
+	std::vector<double> EList = linspace(-5.0, 5.0, 11);
+	std::vector<double> dosList;
+	totalDensityOfState_free(lattice1D, EList, eta, dosList);
+	for (int i=0; i<EList.size(); ++i) {
+		double rho = 0.0;
+		for (int k=0; k<eigenValues.size(); ++k) {
+			double shifted = EList[i] - eigenValues(k);
+			rho += eta/(shifted*shifted + eta*eta)/M_PI;
+		}
+		EXPECT_NEAR(dosList[i], rho, 1e-10);
+	}
+}
@@ -0,0 +1,167 @@
+/*
+ * lead.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "lead.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+
+
+int decimateLead(const CDMatrix& W, const CDMatrix& Alpha, const CDMatrix& Beta,
+		         CDMatrix& ARight, CDMatrix& ATildeLeft,
+		         double tolerance, int maxIterations) {
+	/**
+	 * Eliminating the odd cells with U_{J+1} = W^{-1}*(alpha*U_{J} + beta*U_{J+2})
+	 * leaves a chain of the even cells with
+	 *
+	 *   W     ==> W - alpha*W^{-1}*beta - beta*W^{-1}*alpha
+	 *   alpha ==> alpha*W^{-1}*alpha
+	 *   beta  ==> beta*W^{-1}*beta
+	 *
+	 * The surface cell of a lead only loses one of its neighbors.
+	 */
+	CDMatrix epsilon = W;
+	CDMatrix epsilonRight = W;
+	CDMatrix epsilonLeft = W;
+	CDMatrix alpha = Alpha;
+	CDMatrix beta = Beta;
+	double scale = W.norm();
+
+	int iteration = 0;
+	while (alpha.norm() + beta.norm() > tolerance*scale) {
+		if (iteration == maxIterations) {
+			std::cout << "The decimation of the lead has not converged after "
+					  << maxIterations << " steps" << std::endl;
+			exit(-1);
+		}
+		CDMatrix gAlpha, gBeta;
+		solveDenseLinearEqs(epsilon, alpha, gAlpha);
+		solveDenseLinearEqs(epsilon, beta, gBeta);
+
+		CDMatrix betaGAlpha = beta*gAlpha;
+		CDMatrix alphaGBeta = alpha*gBeta;
+		epsilonRight -= betaGAlpha;
+		epsilonLeft -= alphaGBeta;
+		epsilon -= betaGAlpha + alphaGBeta;
+		alpha = alpha*gAlpha;
+		beta = beta*gBeta;
+		++iteration;
+	}
+
+	CDMatrix coupling = Alpha;
+	solveDenseLinearEqs(epsilonRight, coupling, ARight);
+	coupling = Beta;
+	solveDenseLinearEqs(epsilonLeft, coupling, ATildeLeft);
+	return iteration;
+}
+
+
+void formLeadCell(const StripData& strip, DisorderStream& stream, int K,
+		          dcomplex z, CDMatrix& W, CDMatrix& Alpha, CDMatrix& Beta) {
+	int N = strip.blockSize;
+	int p = strip.step;
+	CDMatrix W0, Alpha0, Beta0, W1, Alpha1, Beta1;
+	formStripBlocks(strip, stream, K, z, W0, Alpha0, Beta0);
+	formStripBlocks(strip, stream, K+p, z, W1, Alpha1, Beta1);
+
+	/**
+	 *   W_{K}*V_{K} - beta_{K}*V_{K+p} = alpha_{K}*V_{K-p}
+	 *   W_{K+p}*V_{K+p} - alpha_{K+p}*V_{K} = beta_{K+p}*V_{K+2p}
+	 */
+	W.resize(2*N, 2*N);
+	W << W0, -Beta0,
+		 -Alpha1, W1;
+	Alpha = CDMatrix::Zero(2*N, 2*N);
+	Alpha.topRightCorner(N, N) = Alpha0;
+	Beta = CDMatrix::Zero(2*N, 2*N);
+	Beta.bottomLeftCorner(N, N) = Beta1;
+}
+
+
+void openStripGreenFuncLine(InteractionData& interactionData,
+		                    OpenStripData& openStripData, int n, int a,
+		                    dcomplex z, int mMin, int mMax, CDVector& line) {
+	StripData strip;
+	setUpStrip(interactionData, openStripData.rMax, strip);
+	int N = strip.blockSize;
+	int p = strip.step;
+	int rMax = strip.rMax;
+	if (a < 1 || a > rMax) {
+		std::cout << "The separation " << a << " is not on the strip" << std::endl;
+		exit(-1);
+	}
+
+	/**
+	 * shift the sites so that the region and the first cells of the leads
+	 * stay away from site 0, where formStripBlocks has a hard wall
+	 */
+	int shift = -min(0, min(mMin, n)) + rMax + 2*p;
+	int windowFirst = shift;
+	int windowLast = shift + openStripData.length - 1;
+	DisorderStream stream(interactionData, windowFirst, windowLast);
+
+	// the explicit region covers every k that contains a disordered site or
+	// an element of the line
+	int kLow = min(2*windowFirst - rMax, 2*(min(mMin, n)+shift) + a);
+	int kHigh = max(2*windowLast + rMax, 2*(max(mMax, n)+shift) + a);
+	int K0 = kLow;
+	int numBlocks = (kHigh-K0)/p + 1;
+
+	std::vector<CDMatrix> W(numBlocks), Alpha(numBlocks), Beta(numBlocks);
+	for (int j=0; j<numBlocks; ++j) {
+		formStripBlocks(strip, stream, K0+j*p, z, W[j], Alpha[j], Beta[j]);
+	}
+
+	// the leads: A_{K0+numBlocks*p} and ATilde_{K0-p}
+	CDMatrix cellW, cellAlpha, cellBeta, ACell, ATildeCell;
+	std::vector<CDMatrix> A(numBlocks+1), ATilde(numBlocks);
+	formLeadCell(strip, stream, K0+numBlocks*p, z, cellW, cellAlpha, cellBeta);
+	decimateLead(cellW, cellAlpha, cellBeta, ACell, ATildeCell,
+			openStripData.tolerance, openStripData.maxIterations);
+	A[numBlocks] = ACell.topRightCorner(N, N);
+
+	formLeadCell(strip, stream, K0-2*p, z, cellW, cellAlpha, cellBeta);
+	decimateLead(cellW, cellAlpha, cellBeta, ACell, ATildeCell,
+			openStripData.tolerance, openStripData.maxIterations);
+	CDMatrix ATildeLead = ATildeCell.bottomLeftCorner(N, N);
+
+	int kc = 2*(n+shift) + a;
+	int c = (kc-K0)/p;
+
+	// from the right lead to the center: V_{K} = A_{K}*V_{K-p}
+	for (int j=numBlocks-1; j>c; --j) {
+		CDMatrix leftSide = W[j];
+		leftSide.noalias() -= Beta[j]*A[j+1];
+		solveDenseLinearEqs(leftSide, Alpha[j], A[j]);
+	}
+	// from the left lead to the center: V_{K} = ATilde_{K}*V_{K+p}
+	for (int j=0; j<c; ++j) {
+		CDMatrix leftSide = W[j];
+		leftSide.noalias() -= Alpha[j]*(j==0 ? ATildeLead : ATilde[j-1]);
+		solveDenseLinearEqs(leftSide, Beta[j], ATilde[j]);
+	}
+
+	// W_{Kc}*V_{Kc} = alpha_{Kc}*V_{Kc-p} + beta_{Kc}*V_{Kc+p} + C
+	CDMatrix leftSide = W[c];
+	leftSide.noalias() -= Alpha[c]*(c==0 ? ATildeLead : ATilde[c-1]);
+	leftSide.noalias() -= Beta[c]*A[c+1];
+	CDMatrix C = CDMatrix::Zero(N, 1);
+	C(stripIndex(strip, K0+c*p, kc, a), 0) = 1.0;
+	std::vector<CDMatrix> V(numBlocks);
+	solveDenseLinearEqs(leftSide, C, V[c]);
+	for (int j=c+1; j<numBlocks; ++j) {
+		V[j] = A[j]*V[j-1];
+	}
+	for (int j=c-1; j>=0; --j) {
+		V[j] = ATilde[j]*V[j+1];
+	}
+
+	line.resize(mMax-mMin+1);
+	for (int m=mMin; m<=mMax; ++m) {
+		int k = 2*(m+shift) + a;
+		int j = (k-K0)/p;
+		line(m-mMin) = V[j](stripIndex(strip, K0+j*p, k, a), 0);
+	}
+}
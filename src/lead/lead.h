@@ -0,0 +1,78 @@
+/*
+ * lead.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Semi-infinite clean leads attached to a finite disordered region.
+ *
+ * Far from the disorder the blocks W_K, alpha_K and beta_K of the strip (see
+ * transferMatrix.h) repeat themselves, so the A matrices of the recursion
+ *
+ *       A_{K} = ( W_{K} - beta_{K}*A_{K+p} )^{-1} * alpha_{K}
+ *
+ * converge to a fixed point. Instead of iterating the recursion from a far
+ * away boundary, the fixed point is obtained by decimation (Sancho-Rubio):
+ * every step eliminates every other cell of the lead, so after n steps the
+ * lead is 2^n cells long.
+ *
+ * The blocks of K and K+p differ when p is odd (r has the parity of k), so
+ * a cell of the lead always contains two blocks [V_K; V_{K+p}].
+ *
+ * This needs a constant block size, so it is only done for the strip
+ * 1 <= x2 - x1 <= rMax; on the whole lattice the size of V_K changes with K
+ * and A_K has no fixed point.
+ */
+
+#ifndef LEAD_H_
+#define LEAD_H_
+
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../transferMatrix/transferMatrix.h"
+
+
+/**
+ * the fixed points of a chain of identical cells
+ *
+ *       W*U_{J} = Alpha*U_{J-1} + Beta*U_{J+1}
+ *
+ * ARight: U_{0} = ARight*U_{-1} for the lead J >= 0 on the right
+ * ATildeLeft: U_{0} = ATildeLeft*U_{1} for the lead J <= 0 on the left
+ *
+ * The decimation stops when the effective couplings are below
+ * tolerance*|W|; the number of decimation steps is returned. Im(z) must be
+ * positive, otherwise it does not converge inside the band.
+ */
+int decimateLead(const CDMatrix& W, const CDMatrix& Alpha, const CDMatrix& Beta,
+		         CDMatrix& ARight, CDMatrix& ATildeLeft,
+		         double tolerance, int maxIterations);
+
+/**
+ * the cell [V_K; V_{K+p}] of the strip (2N x 2N matrices)
+ */
+void formLeadCell(const StripData& strip, DisorderStream& stream, int K,
+		          dcomplex z, CDMatrix& W, CDMatrix& Alpha, CDMatrix& Beta);
+
+
+typedef struct {
+	int rMax;
+	// the disordered sites are 0, 1, ..., length-1; the rest of the infinite
+	// chain is clean
+	int length;
+	double tolerance; // of the decimation
+	int maxIterations;
+} OpenStripData;
+
+
+/**
+ * G(m, m+a; n, n+a) for mMin <= m <= mMax on the infinite chain: line(m-mMin)
+ *
+ * m and n may also lie in the clean part of the chain; only the onsite
+ * energies may be random (see setUpStrip) and 1 <= a <= rMax
+ */
+void openStripGreenFuncLine(InteractionData& interactionData,
+		                    OpenStripData& openStripData, int n, int a,
+		                    dcomplex z, int mMin, int mMax, CDVector& line);
+
+#endif /* LEAD_H_ */
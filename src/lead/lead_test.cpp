@@ -0,0 +1,91 @@
+/*
+ * lead_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "lead.h"
+
+
+TEST(DecimateLead, FixedPoint) {
+	InteractionData interactionData = {2.0, 1.0, 1.0, true, false, false, 3, 1,
+			                           true, true};
+	StripData strip;
+	setUpStrip(interactionData, 6, strip);
+	DisorderStream stream(interactionData, 0, -1); // clean everywhere
+	dcomplex z(0.4, 0.05);
+	CDMatrix W, Alpha, Beta, ARight, ATildeLeft;
+	formLeadCell(strip, stream, 30, z, W, Alpha, Beta);
+	int steps = decimateLead(W, Alpha, Beta, ARight, ATildeLeft, 1e-14, 100);
+	EXPECT_LT(steps, 40);
+
+	// A = (W - Beta*A)^{-1}*Alpha and ATilde = (W - Alpha*ATilde)^{-1}*Beta
+	CDMatrix rightResidual = (W - Beta*ARight)*ARight - Alpha;
+	CDMatrix leftResidual = (W - Alpha*ATildeLeft)*ATildeLeft - Beta;
+	EXPECT_LT(rightResidual.norm(), 1e-10);
+	EXPECT_LT(leftResidual.norm(), 1e-10);
+}
+
+
+TEST(OpenStripGreenFuncLine, CleanChain) {
+	// rMax = 2: the states (x, x+1), (x, x+2), (x+1, x+2), ... form a chain
+	// with hopping 1, so G(n, n+1; n, n+1) = 1/sqrt(z^2-4)
+	InteractionData interactionData = {0.0, 1.0, 0.0, false, false, false, 1, 1,
+			                           false, false};
+	OpenStripData openStripData = {2, 0, 1e-14, 100};
+	dcomplex zList[3] = {dcomplex(0.5, 0.01), dcomplex(3.0, 1e-6), dcomplex(-2.5, 0.1)};
+	for (int i=0; i<3; ++i) {
+		dcomplex z = zList[i];
+		CDVector line;
+		openStripGreenFuncLine(interactionData, openStripData, 0, 1, z, -3, 3, line);
+		dcomplex expected = 1.0/(std::sqrt(z-2.0)*std::sqrt(z+2.0));
+		EXPECT_NEAR(std::abs(line(3) - expected), 0.0, 1e-8);
+		// translation invariance
+		EXPECT_NEAR(std::abs(line(1) - line(5)), 0.0, 1e-8);
+	}
+}
+
+
+TEST(OpenStripGreenFuncLine, SameAsLongFiniteStrip) {
+	InteractionData interactionData = {2.5, 1.0, 0.8, true, false, false, 2, 7,
+			                           true, true};
+	int rMax = 4;
+	int length = 12;
+	OpenStripData openStripData = {rMax, length, 1e-14, 200};
+	dcomplex z(0.3, 0.3);
+	int n = 5, a = 2;
+	CDVector line;
+	openStripGreenFuncLine(interactionData, openStripData, n, a, z, -4, 15, line);
+
+	// the same window in the middle of a long strip with hard walls at both ends
+	StripData strip;
+	setUpStrip(interactionData, rMax, strip);
+	int N = strip.blockSize;
+	int p = strip.step;
+	int shift = 100;
+	DisorderStream stream(interactionData, shift, shift+length-1);
+	int K0 = rMax;
+	int numBlocks = (2*shift+length)/p + 100;
+	CDMatrix H = CDMatrix::Zero(N*numBlocks, N*numBlocks);
+	for (int j=0; j<numBlocks; ++j) {
+		CDMatrix W, Alpha, Beta;
+		formStripBlocks(strip, stream, K0+j*p, z, W, Alpha, Beta);
+		H.block(j*N, j*N, N, N) = W;
+		if (j>0) H.block(j*N, (j-1)*N, N, N) = -Alpha;
+		if (j<numBlocks-1) H.block(j*N, (j+1)*N, N, N) = -Beta;
+	}
+	CDVector C = CDVector::Zero(N*numBlocks);
+	int kc = 2*(n+shift) + a;
+	int jc = (kc-K0)/p;
+	C(jc*N + stripIndex(strip, K0+jc*p, kc, a)) = 1.0;
+	CDVector G = H.partialPivLu().solve(C);
+
+	for (int m=-4; m<=15; ++m) {
+		int k = 2*(m+shift) + a;
+		int j = (k-K0)/p;
+		dcomplex expected = G(j*N + stripIndex(strip, K0+j*p, k, a));
+		EXPECT_NEAR(std::abs(line(m+4) - expected), 0.0, 1e-10*std::abs(expected));
+	}
+}
@@ -77,23 +77,17 @@ TEST(LocalizationTest, RandomOnSiteEnergy) {
 
 	zList.push_back(dcomplex(E, eta));
 
-	std::vector<std::string> fileList;
-	//fileList.push_back("GF.txt");
-	fileList.push_back("GF.bin");
-
-	calculateAllGreenFunc(lattice1D,  initialSites,
-			              interactionData, zList,
-	                       fileList);
-	// extract Green's function from the file
-	CDMatrix gf;
-	loadMatrix(fileList[0], gf);
+	// only G(m, m+a; n, n+a) is needed, so don't form the whole matrix
+	std::vector<CDVector> lineList;
+	calculateGreenFuncLine(lattice1D, initialSites, interactionData, zList,
+			initialSeperation, n, xmax-initialSeperation, lineList);
 
 	std::ofstream myFile;
 	std::string output = "a_" + itos(initialSeperation)+".txt";
 
 	myFile.open(output.c_str());
 	for (int m=n; m<=xmax-initialSeperation; ++m ) {
-		dcomplex element = gf(m, m+initialSeperation);
+		dcomplex element = lineList[0](m-n);
 		double G_n_m = std::log( std::abs( element ) );
 		myFile << (m-n) << "\t"<< G_n_m << std::endl;
 	}
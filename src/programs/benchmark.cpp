@@ -0,0 +1,326 @@
+/*
+ * benchmark.cpp
+ *
+ *  Created on: Oct 21, 2026
+ *      Author: pxiang
+ *
+ * A separate executable that times the building blocks of the recursive
+ * calculation over a grid of (xmax, maxDistance, number of threads) and
+ * writes the results in JSON format.
+ *
+ * usage:
+ *   bench [--xmax 61,101] [--maxDistance 1,2,4] [--threads 1,2]
+ *         [--repeat 5] [--output bench.json]
+ *         [--baseline baseline.json] [--tolerance 0.2]
+ *         [--directLimit 3000]
+ *
+ * If a baseline is given, the medians are compared with it and the program
+ * returns the number of regressions (0 means no regression).
+ *
+ * Compiled with -DPROFILING, it also prints the per-phase profile of all the
+ * cases and writes the timeline to bench_trace.json.
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../benchmark/benchmark.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+#include "../directCalculation/direct_calculation.h"
+#include "../sparseCalculation/sparseSolver.h"
+
+
+/**
+ * everything a benchmarked function needs
+ */
+typedef struct {
+	LatticeShape *pLattice;
+	InteractionData interactionData;
+	Basis *pInitialSites;
+	RecursionData recursionData;
+	dcomplex z;
+	int K; // the K used by the single-block cases
+	CDMatrix W, Alpha, Beta;
+	CDMatrix gf; // used by the I/O cases
+} BenchmarkContext;
+
+typedef double (*BenchmarkFunction)(BenchmarkContext& context);
+
+
+/********************** the benchmarked functions ***********************/
+/**
+ * each function returns the number of floating point operations (0 if it is
+ * not meaningful). Complex multiply-add counts as 8 real operations.
+ */
+
+// (m x k) * (k x n) complex matrix product
+static double gemmFlops(double m, double k, double n) {
+	return 8.0*m*k*n;
+}
+
+// column-pivoting Householder QR of an n x n complex matrix + solve with m rhs
+static double solveFlops(double n, double m) {
+	return 4.0*(4.0/3.0*n*n*n) + 4.0*(4.0*n*n*m + n*n*m);
+}
+
+// LDL^T (Bunch-Kaufman) of an n x n complex symmetric matrix + solve with m
+// rhs, as used by the sweeps: n^3/3 and n^2*m complex multiply-adds
+static double symmetricSolveFlops(double n, double m) {
+	return 8.0*(n*n*n/3.0) + 8.0*n*n*m;
+}
+
+
+static double benchFormMatrices(BenchmarkContext& context) {
+	formMatrixW(context.K, context.z, context.W);
+	formMatrixAlpha(context.K, context.Alpha);
+	formMatrixBeta(context.K, context.Beta);
+	return 0.0;
+}
+
+
+static double benchSolveDenseLinearEqs(BenchmarkContext& context) {
+	CDMatrix X;
+	solveDenseLinearEqs(context.W, context.Alpha, X);
+	return solveFlops(context.W.rows(), context.Alpha.cols());
+}
+
+
+/**
+ * the number of operations of one sweep from the right end to KRightStop:
+ * a product BetaK*AKPlus and a symmetric solve for every K
+ */
+static double sweepFlops(RecursionData& rd) {
+	extern std::vector<int> DimsOfV;
+	int maxDistance = rd.maxDistance;
+	int Kmax = DimsOfV.size()-1;
+	double flops = 0.0;
+	// the size of V_K
+	std::vector<double> sizeOfV(Kmax+1, 0.0);
+	for (int K=1; K<=Kmax; ++K) {
+		for (int i=0; i<maxDistance && K+i<=Kmax; ++i) {
+			sizeOfV[K] += DimsOfV[K+i];
+		}
+	}
+	for (int K=rd.KRightStart-maxDistance; K>=rd.KRightStop; K-=maxDistance) {
+		double n = sizeOfV[K];
+		flops += gemmFlops(n, sizeOfV[K+maxDistance], sizeOfV[K]);
+		flops += symmetricSolveFlops(n, sizeOfV[K-maxDistance]);
+	}
+	for (int K=rd.KLeftStart+maxDistance; K<=rd.KLeftStop; K+=maxDistance) {
+		double n = sizeOfV[K];
+		flops += gemmFlops(n, sizeOfV[K-maxDistance], sizeOfV[K]);
+		flops += symmetricSolveFlops(n, sizeOfV[K+maxDistance]);
+	}
+	return flops;
+}
+
+
+static double benchSweep(BenchmarkContext& context) {
+	CDMatrix ATildeKLeftStop;
+	fromLeftToCenter(context.recursionData, context.z, ATildeKLeftStop, false);
+	CDMatrix AKRightStop;
+	fromRightToCenter(context.recursionData, context.z, AKRightStop, false);
+	CDMatrix VKCenter;
+	solveVKCenter(context.recursionData, context.z, ATildeKLeftStop,
+			      AKRightStop, VKCenter);
+	return sweepFlops(context.recursionData);
+}
+
+
+static double benchCalculateAllGreenFunc(BenchmarkContext& context) {
+	std::vector<dcomplex> zList(1, context.z);
+	std::vector<std::string> fileList(1, "bench_GF.bin");
+	calculateAllGreenFunc(*context.pLattice, *context.pInitialSites,
+			              context.interactionData, zList, fileList);
+	deleteMatrixFiles("bench_GF.bin");
+	// the timing includes the A files and the output, so a GFLOP/s figure
+	// would be meaningless (the "sweep" case gives it for the sweeps alone)
+	return 0.0;
+}
+
+
+static double benchDirect(BenchmarkContext& context) {
+	std::vector<dcomplex> zList(1, context.z);
+	std::vector<dcomplex> gfList;
+	greenFunc_direct(*context.pLattice, *context.pInitialSites,
+			         *context.pInitialSites, zList, gfList);
+	return 0.0;
+}
+
+
+static double benchSparse(BenchmarkContext& context) {
+	std::vector<dcomplex> zList(1, context.z);
+	std::vector<dcomplex> gfList;
+	greenFunc_sparse(*context.pLattice, *context.pInitialSites,
+			         *context.pInitialSites, zList, gfList);
+	return 0.0;
+}
+
+
+static double benchBinaryIO(BenchmarkContext& context) {
+	saveMatrixBin("bench_io.bin", context.gf);
+	CDMatrix m;
+	loadMatrixBin("bench_io.bin", m);
+	return 0.0;
+}
+
+
+static double benchTextIO(BenchmarkContext& context) {
+	saveMatrixText("bench_io.txt", context.gf);
+	CDMatrix m;
+	loadMatrixText("bench_io.txt", m);
+	return 0.0;
+}
+/************************************************************************/
+
+
+
+/**
+ * run a function "repeat" times and record the timings
+ */
+static void runCase(std::string name, BenchmarkFunction function,
+		            BenchmarkContext& context, int repeat, int xmax,
+		            int maxDistance, int threads, double bytes,
+		            std::vector<BenchmarkCase>& cases) {
+	BenchmarkCase benchmarkCase;
+	benchmarkCase.name = name;
+	benchmarkCase.xmax = xmax;
+	benchmarkCase.maxDistance = maxDistance;
+	benchmarkCase.threads = threads;
+	benchmarkCase.flops = 0.0;
+	benchmarkCase.bytes = bytes;
+	for (int r=0; r<repeat; ++r) {
+		double start = wallTime();
+		benchmarkCase.flops = function(context);
+		benchmarkCase.samples.push_back(wallTime() - start);
+	}
+	benchmarkCase.peakRSS = peakResidentMemory();
+	std::cout << benchmarkKey(benchmarkCase) << ": median = "
+			  << percentile(benchmarkCase.samples, 50.0) << " s" << std::endl;
+	cases.push_back(benchmarkCase);
+}
+
+
+/**
+ * parse a comma-separated list of integers, e.g. 1,2,4
+ */
+static std::vector<int> parseIntList(std::string s) {
+	std::vector<int> list;
+	std::istringstream iss(s);
+	std::string token;
+	while (getline(iss, token, ',')) {
+		list.push_back(atoi(token.c_str()));
+	}
+	return list;
+}
+
+
+int main(int argc, char **argv) {
+	std::vector<int> xmaxList = parseIntList("61,101");
+	std::vector<int> maxDistanceList = parseIntList("1,2,4");
+	std::vector<int> threadsList = parseIntList("1");
+	int repeat = 5;
+	std::string output = "bench.json";
+	std::string baseline = "";
+	double tolerance = 0.2;
+	// the direct method is only run if the number of basis sets is below this
+	int directLimit = 3000;
+
+	for (int i=1; i<argc-1; i+=2) {
+		std::string option = argv[i];
+		std::string value = argv[i+1];
+		if (option=="--xmax") {
+			xmaxList = parseIntList(value);
+		} else if (option=="--maxDistance") {
+			maxDistanceList = parseIntList(value);
+		} else if (option=="--threads") {
+			threadsList = parseIntList(value);
+		} else if (option=="--repeat") {
+			repeat = atoi(value.c_str());
+		} else if (option=="--output") {
+			output = value;
+		} else if (option=="--baseline") {
+			baseline = value;
+		} else if (option=="--tolerance") {
+			tolerance = atof(value.c_str());
+		} else if (option=="--directLimit") {
+			directLimit = atoi(value.c_str());
+		} else {
+			std::cout << "Unknown option " << option << std::endl;
+			return -1;
+		}
+	}
+
+	std::vector<BenchmarkCase> cases;
+
+	for (int t=0; t<threadsList.size(); ++t) {
+		int threads = threadsList[t];
+#ifdef _OPENMP
+		omp_set_num_threads(threads);
+#endif
+		Eigen::setNbThreads(threads);
+
+		for (int i=0; i<xmaxList.size(); ++i) {
+			int xmax = xmaxList[i];
+			LatticeShape lattice1D(1);
+			lattice1D.setXmax(xmax);
+			Basis initialSites(xmax/2, xmax/2+1);
+
+			// the I/O cases don't depend on maxDistance
+			BenchmarkContext ioContext;
+			ioContext.gf = CDMatrix::Random(xmax+1, xmax+1);
+			double bytes = 2.0*sizeof(dcomplex)*(xmax+1)*(xmax+1);
+			runCase("binaryIO", benchBinaryIO, ioContext, repeat, xmax, 0,
+					threads, bytes, cases);
+			runCase("textIO", benchTextIO, ioContext, repeat, xmax, 0,
+					threads, 0.0, cases);
+			deleteMatrixFiles("bench_io.bin bench_io.txt");
+
+			for (int j=0; j<maxDistanceList.size(); ++j) {
+				int maxDistance = maxDistanceList[j];
+				BenchmarkContext context;
+				InteractionData interactionData = {1.0,1.0,1.0,true,false,false,
+						                           maxDistance,230,true,true};
+				context.interactionData = interactionData;
+				context.pLattice = &lattice1D;
+				context.pInitialSites = &initialSites;
+				context.z = dcomplex(0.0, 0.01);
+
+				setUpIndexInteractions(lattice1D, context.interactionData);
+				setUpRecursion(lattice1D, context.interactionData, initialSites,
+						       context.recursionData);
+				// a block in the bulk of the right sweep
+				context.K = context.recursionData.KRightStop;
+
+				runCase("formMatrixWAlphaBeta", benchFormMatrices, context, repeat,
+						xmax, maxDistance, threads, 0.0, cases);
+				runCase("solveDenseLinearEqs", benchSolveDenseLinearEqs, context,
+						repeat, xmax, maxDistance, threads, 0.0, cases);
+				runCase("sweep", benchSweep, context, repeat,
+						xmax, maxDistance, threads, 0.0, cases);
+				runCase("calculateAllGreenFunc", benchCalculateAllGreenFunc, context,
+						repeat, xmax, maxDistance, threads, 0.0, cases);
+				runCase("sparseLU", benchSparse, context, repeat,
+						xmax, maxDistance, threads, 0.0, cases);
+				if ((xmax+1)*xmax/2<=directLimit) {
+					runCase("direct", benchDirect, context, repeat,
+							xmax, maxDistance, threads, 0.0, cases);
+				}
+			}
+		}
+	}
+
+	writeBenchmarkJSON(output, cases);
+	std::cout << "The results are saved in " << output << std::endl;
+	PROFILE_REPORT("bench_trace.json");
+
+	int regressions = 0;
+	if (!baseline.empty()) {
+		std::map<std::string, double> medians;
+		readBenchmarkBaseline(baseline, medians);
+		regressions = compareWithBaseline(cases, medians, tolerance);
+		std::cout << regressions << " regression(s) found" << std::endl;
+	}
+	return regressions;
+}
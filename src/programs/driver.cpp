@@ -0,0 +1,35 @@
+/*
+ * driver.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ *
+ * Run the production jobs of a job file without the test harness.
+ *
+ * usage:
+ *   driver job.txt
+ *
+ * See driver/job.h for the format of the job file. A job file with sweeps
+ * describes a list of jobs, "workers" of which run at the same time. The run
+ * manifest of each job (the parameters, the output files and the timings) is
+ * written to <output>_manifest.json.
+ */
+
+#include "../driver/job.h"
+
+
+int main(int argc, char **argv) {
+	if (argc != 2) {
+		std::cout << "usage: " << argv[0] << " job.txt" << std::endl;
+		return -1;
+	}
+
+	std::vector<JobData> jobs;
+	int workers;
+	readJobList(argv[1], defaultJobData(), jobs, workers);
+	std::cout << jobs.size() << " job(s) with " << workers << " worker(s)" << std::endl;
+
+	int failed = runJobs(jobs, workers, argv[1]);
+	std::cout << failed << " job(s) failed" << std::endl;
+	return failed;
+}
@@ -0,0 +1,79 @@
+/*
+ * ensemble.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Average ln|G(m, m+a; n, n+a)| over many realizations of the disorder and
+ * fit the inverse two-particle localization length.
+ *
+ * usage:
+ *   ensemble input.txt
+ *
+ * Besides the lattice and interaction variables of input.txt (xmax, onsiteE,
+ * hop, dyn, randomOnsite, ..., seed, E, eta), the input file may contain
+ *
+ *   int realizations 1000         (seeds seed, seed+1, ...)
+ *   int initialSeperation 1       (a)
+ *   int initialSite 50            (n, default xmax/2)
+ *   int workers 4
+ *   int checkpointInterval 100    (0: no checkpoint)
+ *   string checkpoint ensemble.chk
+ *   bool resume true
+ *   int fitMin 10                 (the range of m-n used in the fit)
+ *   int fitMax 40                 (default: the largest m-n)
+ *   string output ensemble.txt    (r, <<ln|G|>>, error, <<|G|^2>>)
+ */
+
+#include "../ensemble/ensemble.h"
+#include "../IO/configParser.h"
+
+
+int main(int argc, char **argv) {
+	if (argc != 2) {
+		std::cout << "usage: " << argv[0] << " input.txt" << std::endl;
+		return -1;
+	}
+	InputConfig config;
+	config.read(argv[1]);
+
+	EnsembleData ensembleData;
+	ensembleData.xmax = config.getInt("xmax", 101);
+	InteractionData interactionData = {
+			config.getDouble("onsiteE", 2.5),
+			config.getDouble("hop", 1.0),
+			config.getDouble("dyn", 1.0),
+			config.getBool("randomOnsite", true),
+			config.getBool("randomHop", false),
+			config.getBool("randomDyn", false),
+			config.getInt("maxDistance", 4),
+			config.getUnsigned("seed", 100),
+			config.getBool("longRangeHop", true),
+			config.getBool("longRangeDyn", true)};
+	ensembleData.interactionData = interactionData;
+	ensembleData.initialSite = config.getInt("initialSite", ensembleData.xmax/2);
+	ensembleData.separation = config.getInt("initialSeperation", 1);
+	ensembleData.z = dcomplex(config.getDouble("E", 0.0), config.getDouble("eta", 0.01));
+	ensembleData.numRealizations = config.getInt("realizations", 100);
+	ensembleData.workers = max(config.getInt("workers", 1), 1);
+	ensembleData.checkpointInterval = config.getInt("checkpointInterval", 0);
+	ensembleData.checkpointFile = config.getString("checkpoint", "ensemble.chk");
+	ensembleData.resume = config.getBool("resume", false);
+
+	EnsembleSums sums;
+	runEnsemble(ensembleData, sums);
+
+	std::string output = config.getString("output", "ensemble.txt");
+	saveEnsembleAverages(output, sums);
+
+	std::vector<double> meanLnG, errorLnG, meanAbsG2;
+	ensembleAverages(sums, meanLnG, errorLnG, meanAbsG2);
+	int fitMin = config.getInt("fitMin", 0);
+	int fitMax = config.getInt("fitMax", meanLnG.size()-1);
+	std::cout << sums.realizations << " realizations, averages saved in "
+			  << output << std::endl;
+	std::cout << "inverse localization length (fit over " << fitMin << " <= m-n <= "
+			  << fitMax << "): "
+			  << fitInverseLocalizationLength(meanLnG, fitMin, fitMax) << std::endl;
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * lyapunov.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * The inverse two-particle localization length from the smallest positive
+ * Lyapunov exponent of the transfer matrices of one long chain.
+ *
+ * usage:
+ *   lyapunov input.txt
+ *
+ * Besides the interaction variables of input.txt (onsiteE, hop, dyn,
+ * randomOnsite, ..., seed, E, eta), the input file may contain
+ *
+ *   int rMax 16                   (largest distance of the pair, a multiple of 2*p)
+ *   int numBlocks 100000          (the chain is numBlocks*p/2 sites long)
+ *   int warmupBlocks 1000
+ *   int qrInterval 8
+ *   int numSegments 20            (for the error estimate)
+ *   string output lyapunov.txt    (all the exponents)
+ */
+
+#include "../transferMatrix/transferMatrix.h"
+#include "../IO/configParser.h"
+#include <iomanip>
+
+
+int main(int argc, char **argv) {
+	if (argc != 2) {
+		std::cout << "usage: " << argv[0] << " input.txt" << std::endl;
+		return -1;
+	}
+	InputConfig config;
+	config.read(argv[1]);
+
+	InteractionData interactionData = {
+			config.getDouble("onsiteE", 2.5),
+			config.getDouble("hop", 1.0),
+			config.getDouble("dyn", 1.0),
+			config.getBool("randomOnsite", true),
+			config.getBool("randomHop", false),
+			config.getBool("randomDyn", false),
+			config.getInt("maxDistance", 4),
+			config.getUnsigned("seed", 100),
+			config.getBool("longRangeHop", true),
+			config.getBool("longRangeDyn", true)};
+
+	TransferMatrixData transferMatrixData;
+	transferMatrixData.rMax = config.getInt("rMax", 16);
+	transferMatrixData.z = dcomplex(config.getDouble("E", 0.0), config.getDouble("eta", 0.0));
+	transferMatrixData.numBlocks = config.getInt("numBlocks", 100000);
+	transferMatrixData.warmupBlocks = config.getInt("warmupBlocks", 1000);
+	transferMatrixData.qrInterval = config.getInt("qrInterval", 8);
+	transferMatrixData.numSegments = config.getInt("numSegments", 20);
+
+	double start = wallTime();
+	LyapunovResult result;
+	lyapunovExponents(interactionData, transferMatrixData, result);
+
+	std::string output = config.getString("output", "lyapunov.txt");
+	std::ofstream out(output.c_str());
+	out << std::setprecision(15);
+	for (int i=0; i<result.exponents.size(); ++i) {
+		out << i << "\t" << result.exponents[i] << "\n";
+	}
+	out.close();
+
+	std::cout << "inverse localization length: " << result.inverseLocalizationLength
+			  << " +- " << result.error << std::endl;
+	std::cout << "exponents saved in " << output << " ("
+			  << wallTime()-start << " s)" << std::endl;
+	return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * bandedSolver.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "bandedSolver.h"
+#include <algorithm>
+
+
+void siteOrdering(int K, int maxDistance, std::vector<int>& order) {
+	extern std::vector< std::vector< Basis > > VtoG;
+	int Kmax = VtoG.size()-1;
+	// (x1, x1 + x2, row in V_K)
+	std::vector< std::pair< std::pair<int, int>, int> > keys;
+	int row = 0;
+	for (int k=K; k<=min(K+maxDistance-1, Kmax); ++k) {
+		for (int i=0; i<VtoG[k].size(); ++i) {
+			keys.push_back(std::make_pair(std::make_pair(VtoG[k][i][0], k), row++));
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+	order.resize(keys.size());
+	for (int i=0; i<keys.size(); ++i) {
+		order[i] = keys[i].second;
+	}
+}
+
+
+void bandwidths(const CDMatrix& A, const std::vector<int>& order, int& lower, int& upper) {
+	int n = order.size();
+	lower = 0;
+	upper = 0;
+	for (int j=0; j<n; ++j) {
+		for (int i=0; i<n; ++i) {
+			if (A(order[i], order[j]) != dcomplex(0.0, 0.0)) {
+				lower = max(lower, i-j);
+				upper = max(upper, j-i);
+			}
+		}
+	}
+}
+
+
+void factorizeBanded(const CDMatrix& A, const std::vector<int>& order, BandedLU& factors) {
+	PROFILE_SCOPE("factorizeBanded");
+	int n = order.size();
+	factors.order = order;
+	bandwidths(A, order, factors.lower, factors.upper);
+	int lower = factors.lower;
+	// the row swaps widen U to upper+lower diagonals
+	int width = factors.upper + lower;
+
+	CDMatrix& lu = factors.lu;
+	lu.resize(n, n);
+	for (int j=0; j<n; ++j) {
+		for (int i=0; i<n; ++i) {
+			lu(i, j) = A(order[i], order[j]);
+		}
+	}
+
+	factors.pivots.resize(n);
+	for (int k=0; k<n; ++k) {
+		int rows = min(lower, n-1-k);   // below the diagonal
+		int cols = min(width, n-1-k);   // right of the diagonal
+		int pivot;
+		lu.col(k).segment(k, rows+1).cwiseAbs().maxCoeff(&pivot);
+		pivot += k;
+		factors.pivots[k] = pivot;
+		if (pivot != k) {
+			lu.row(k).segment(k, cols+1).swap(lu.row(pivot).segment(k, cols+1));
+		}
+		if (lu(k, k) == dcomplex(0.0, 0.0)) {
+			std::cout << "The banded matrix is singular" << std::endl;
+			exit(-1);
+		}
+		if (rows == 0) continue;
+		lu.col(k).segment(k+1, rows) /= lu(k, k);
+		lu.block(k+1, k+1, rows, cols).noalias() -=
+				lu.col(k).segment(k+1, rows)*lu.row(k).segment(k+1, cols);
+	}
+}
+
+
+void solveBanded(const BandedLU& factors, const CDMatrix& B, CDMatrix& X) {
+	PROFILE_SCOPE("solveBanded");
+	const std::vector<int>& order = factors.order;
+	const CDMatrix& lu = factors.lu;
+	int n = order.size();
+	int width = factors.upper + factors.lower;
+
+	CDMatrix Y(n, B.cols());
+	for (int i=0; i<n; ++i) {
+		Y.row(i) = B.row(order[i]);
+	}
+	// L, with the row swaps in the order they were made
+	for (int k=0; k<n; ++k) {
+		if (factors.pivots[k] != k) Y.row(k).swap(Y.row(factors.pivots[k]));
+		int rows = min(factors.lower, n-1-k);
+		if (rows > 0) Y.middleRows(k+1, rows).noalias() -= lu.col(k).segment(k+1, rows)*Y.row(k);
+	}
+	// U
+	for (int k=n-1; k>=0; --k) {
+		int cols = min(width, n-1-k);
+		if (cols > 0) Y.row(k).noalias() -= lu.row(k).segment(k+1, cols)*Y.middleRows(k+1, cols);
+		Y.row(k) /= lu(k, k);
+	}
+
+	X.resize(n, B.cols());
+	for (int i=0; i<n; ++i) {
+		X.row(order[i]) = Y.row(i);
+	}
+}
+
+
+bool solveBlockLinearEqs(int K, int maxDistance, CDMatrix& A, CDMatrix& B, CDMatrix& X) {
+	std::vector<int> order;
+	siteOrdering(K, maxDistance, order);
+	int lower, upper;
+	bandwidths(A, order, lower, upper);
+	int n = order.size();
+	// the band costs n*lower*(lower+upper) against n^3/3 for the dense solver
+	if (order.size() != A.rows() || 8*lower*(lower+upper) > n*n) {
+		solveDenseLinearEqs(A, B, X);
+		return false;
+	}
+	BandedLU factors;
+	factorizeBanded(A, order, factors);
+	solveBanded(factors, B, X);
+	return true;
+}
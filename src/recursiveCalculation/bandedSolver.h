@@ -0,0 +1,65 @@
+/*
+ * bandedSolver.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Banded LU factorization of the blocks W_K.
+ *
+ * V_K = [v_K; v_{K+1}; ...; v_{K+maxDistance-1}] stacks the states by the
+ * sum x1 + x2, so the hopping (x1, x2) -> (x1 +- d, x2) couples rows that are
+ * a whole v_k apart. Sorting the rows of V_K by x1 (and then by the sum)
+ * brings every coupled pair within about maxDistance*(maxDistance+1) rows,
+ * and the LU factorization with partial pivoting only has to work inside the
+ * band: O(n*b^2) instead of O(n^3).
+ *
+ * W_K - beta_K*A_{K+} is dense in any ordering, so the band is checked on
+ * the permuted matrix and the dense solver is used when it is not narrow.
+ * W_K alone is only solved at the start of a chain: the first block of a
+ * segmented sweep or of a window cut by truncateRecursion. The starts of the
+ * full recursion sit at the corners of the lattice, where V_K has a handful
+ * of states and the dense solver is used.
+ */
+
+#ifndef BANDEDSOLVER_H_
+#define BANDEDSOLVER_H_
+
+#include "recursiveCalculation.h"
+
+
+/**
+ * the rows of V_K sorted by x1 and then by x1 + x2: row i of the sorted
+ * V_K is row order[i] of V_K
+ */
+void siteOrdering(int K, int maxDistance, std::vector<int>& order);
+
+
+typedef struct {
+	std::vector<int> order;  // see siteOrdering
+	int lower;               // the bandwidths of the permuted matrix
+	int upper;
+	CDMatrix lu;             // L (unit, below the diagonal) and U; U has upper+lower diagonals
+	std::vector<int> pivots; // row k was swapped with row pivots[k] at step k
+} BandedLU;
+
+
+/**
+ * the lower and upper bandwidths of A(order[i], order[j])
+ */
+void bandwidths(const CDMatrix& A, const std::vector<int>& order, int& lower, int& upper);
+
+/**
+ * LU with partial pivoting of A(order[i], order[j]) inside the band
+ */
+void factorizeBanded(const CDMatrix& A, const std::vector<int>& order, BandedLU& factors);
+
+void solveBanded(const BandedLU& factors, const CDMatrix& B, CDMatrix& X);
+
+/**
+ * A*X = B for a block A of V_K: banded if the band of A in the site ordering
+ * is narrow, otherwise solveDenseLinearEqs. Returns true if the banded
+ * solver was used.
+ */
+bool solveBlockLinearEqs(int K, int maxDistance, CDMatrix& A, CDMatrix& B, CDMatrix& X);
+
+#endif /* BANDEDSOLVER_H_ */
@@ -0,0 +1,90 @@
+/*
+ * bandedSolver_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "bandedSolver.h"
+
+
+TEST(BandedSolver, SameAsDenseSolver) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(60);
+	int maxDistance = 4;
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,maxDistance,23,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	dcomplex z(0.3, 0.1);
+
+	int KList[3] = {1, 1+maxDistance*15, 1+maxDistance*29};
+	for (int i=0; i<3; ++i) {
+		int K = KList[i];
+		CDMatrix W;
+		formMatrixW(K, z, W);
+		CDMatrix B = CDMatrix::Identity(W.rows(), 5);
+		std::vector<int> order;
+		siteOrdering(K, maxDistance, order);
+		ASSERT_EQ(order.size(), W.rows());
+		int lower, upper;
+		bandwidths(W, order, lower, upper);
+		EXPECT_LE(lower, maxDistance*(maxDistance+1));
+		EXPECT_LE(upper, maxDistance*(maxDistance+1));
+
+		BandedLU factors;
+		factorizeBanded(W, order, factors);
+		CDMatrix X, XDense;
+		solveBanded(factors, B, X);
+		solveDenseLinearEqs(W, B, XDense);
+		EXPECT_LT((X-XDense).norm(), 1e-12*XDense.norm());
+	}
+
+	// W - beta*A fills the band: the dense solver is used
+	int K = KList[1];
+	CDMatrix W, beta;
+	formMatrixW(K, z, W);
+	formMatrixBeta(K, beta);
+	CDMatrix M = W - beta*CDMatrix::Ones(beta.cols(), W.cols());
+	CDMatrix B = CDMatrix::Identity(W.rows(), 3);
+	CDMatrix X;
+	EXPECT_FALSE(solveBlockLinearEqs(K, maxDistance, M, B, X));
+	EXPECT_TRUE(solveBlockLinearEqs(K, maxDistance, W, B, X));
+	EXPECT_LT((W*X-B).norm(), 1e-12);
+}
+
+
+TEST(BandedSolver, UsedAtTheStartOfAWindow) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(100);
+	int maxDistance = 4;
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,maxDistance,23,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(50, 51);
+	RecursionData fullRecursion;
+	setUpRecursion(lattice1D, interactionData, initialSites, fullRecursion);
+	dcomplex z(0.3, 0.1);
+
+	// the first step of fromRightToCenter: W_{KRightStart}*A = alpha_{KRightStart}
+	CDMatrix W, alpha, A;
+	int K = fullRecursion.KRightStart;
+	formMatrixW(K, z, W);
+	formMatrixAlpha(K, alpha);
+	EXPECT_FALSE(solveBlockLinearEqs(K, maxDistance, W, alpha, A)); // a corner block
+
+	// a window of one block starts next to the center, where W_K is large
+	RecursionData recursionData = fullRecursion;
+	truncateRecursion(recursionData, 1);
+	K = recursionData.KRightStart;
+	ASSERT_EQ(K, recursionData.KRightStop);
+	formMatrixW(K, z, W);
+	formMatrixAlpha(K, alpha);
+	EXPECT_TRUE(solveBlockLinearEqs(K, maxDistance, W, alpha, A));
+
+	// ... and it is the A_{KRightStop} of the truncated recursion
+	CDMatrix AKRightStop;
+	fromRightToCenter(recursionData, z, AKRightStop, false);
+	EXPECT_LT((AKRightStop-A).norm(), 1e-12*A.norm());
+	CDMatrix XDense;
+	solveDenseLinearEqs(W, alpha, XDense);
+	EXPECT_LT((A-XDense).norm(), 1e-10*XDense.norm());
+}
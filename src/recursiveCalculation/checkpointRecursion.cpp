@@ -0,0 +1,127 @@
+/*
+ * checkpointRecursion.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "checkpointRecursion.h"
+#include "bandedSolver.h"
+#include "symmetricSolver.h"
+
+
+int checkpointInterval(int numBlocks, int numCheckpoints) {
+	if (numCheckpoints <= 0) {
+		numCheckpoints = (int) std::ceil(std::sqrt((double) numBlocks));
+	}
+	numCheckpoints = max(1, min(numCheckpoints, numBlocks));
+	return (numBlocks + numCheckpoints - 1)/numCheckpoints;
+}
+
+
+/**
+ * (W_j - outer_j*A_{j+1})*A_j = inner_j; APlus is not used for the
+ * outermost block
+ */
+static void chainStep(const BlockChain& chain, int j, dcomplex z,
+		              const CDMatrix& APlus, CDMatrix& A) {
+	CDMatrix W, inner, outer;
+	formChainBlocks(chain, j, z, W, inner, outer);
+	if (j == chain.numBlocks-1) {
+		solveBlockLinearEqs(chain.K0+j*chain.step, std::abs(chain.step), W, inner, A);
+	} else {
+		W.noalias() -= outer*APlus;
+		solveSymmetricLinearEqs(W, inner, A);
+	}
+}
+
+
+void eliminateChainCheckpointed(const BlockChain& chain, dcomplex z, int interval,
+		                        std::vector<CDMatrix>& checkpoints) {
+	PROFILE_SCOPE("eliminateChainCheckpointed");
+	int n = chain.numBlocks;
+	checkpoints.clear();
+	checkpoints.resize((n + interval - 1)/interval);
+	CDMatrix A, APlus;
+	for (int j=n-1; j>=0; --j) {
+		chainStep(chain, j, z, APlus, A);
+		if (j%interval == 0) checkpoints[j/interval] = A;
+		APlus.swap(A);
+	}
+}
+
+
+int propagateChainCheckpointed(LatticeShape& lattice, const BlockChain& chain,
+		                       dcomplex z, int interval, int numUsed,
+		                       std::vector<CDMatrix>& checkpoints,
+		                       const CDMatrix& VKCenter, CDMatrix& gf) {
+	PROFILE_SCOPE("propagateChainCheckpointed");
+	int n = chain.numBlocks;
+	int numRecomputed = 0;
+	CDMatrix VK = VKCenter;
+	for (int t=0; t*interval<numUsed; ++t) {
+		int first = t*interval;
+		int last = min(first+interval, numUsed) - 1;
+
+		// A_{first+1}, ..., A_{last} from the checkpoint of the next segment
+		std::vector<CDMatrix> blocks(last-first+1);
+		blocks[0].swap(checkpoints[t]);
+		if (last > first) {
+			CDMatrix APlus;
+			if (last+1 < n) APlus = checkpoints[t+1];
+			for (int j=last; j>first; --j) {
+				chainStep(chain, j, z, APlus, blocks[j-first]);
+				APlus = blocks[j-first];
+				numRecomputed++;
+			}
+		}
+
+		for (int j=first; j<=last; ++j) {
+			VK = blocks[j-first]*VK;
+			blocks[j-first].resize(0,0);
+			assignValuesToG(lattice, chain.K0+j*chain.step, std::abs(chain.step), VK, gf);
+		}
+	}
+	return numRecomputed;
+}
+
+
+void calculateAllGreenFuncCheckpointed(LatticeShape& lattice, Basis& initialSites,
+		                               InteractionData& interactionData,
+		                               const std::vector<dcomplex>& zList,
+		                               const std::vector<std::string>& fileList,
+		                               int numCheckpoints) {
+	// for the 1D case, the index for a site = the label of the site
+	int nsite = lattice.getXmax()+1;
+	CDMatrix gf = CDMatrix::Zero(nsite, nsite);
+
+	int maxDistance = interactionData.maxDistance;
+	RecursionData recursionData;
+	setUpRecursion(lattice, interactionData, initialSites, recursionData);
+	BlockChain right = rightChain(recursionData);
+	BlockChain left = leftChain(recursionData);
+	int rightInterval = checkpointInterval(right.numBlocks, numCheckpoints);
+	int leftInterval = checkpointInterval(left.numBlocks, numCheckpoints);
+	// the blocks that calculateAllGreenFunc goes through from V_{KCenter}
+	int rightUsed = recursionData.KRightStart>=recursionData.KRightStop ? right.numBlocks : 0;
+	int leftUsed = recursionData.KLeftStop>=recursionData.KLeftStart ? left.numBlocks : 0;
+
+	for (int i=0; i<zList.size(); ++i) {
+		dcomplex z = zList[i];
+		std::vector<CDMatrix> rightCheckpoints, leftCheckpoints;
+		eliminateChainCheckpointed(right, z, rightInterval, rightCheckpoints);
+		eliminateChainCheckpointed(left, z, leftInterval, leftCheckpoints);
+
+		CDMatrix VKCenter;
+		solveVKCenter(recursionData, z, leftCheckpoints[0], rightCheckpoints[0], VKCenter);
+		assignValuesToG(lattice, recursionData.KCenter, maxDistance, VKCenter, gf);
+
+		propagateChainCheckpointed(lattice, right, z, rightInterval, rightUsed,
+				                   rightCheckpoints, VKCenter, gf);
+		propagateChainCheckpointed(lattice, left, z, leftInterval, leftUsed,
+				                   leftCheckpoints, VKCenter, gf);
+
+		PROFILE_SCOPE("output");
+		saveMatrix(fileList[i], gf);
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ * checkpointRecursion.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * calculateAllGreenFunc without storing every A_K and ATilde_K.
+ *
+ * The A matrices of one side are produced from the outermost block inward
+ * (j = n-1, ..., 0 in the numbering of segmentedRecursion.h) but used from
+ * the center outward (V_j = A_j*V_{j-1}, j = 0, ..., n-1), as in the reverse
+ * mode of automatic differentiation. The blocks are cut into numCheckpoints
+ * segments of s = ceil(n/numCheckpoints) blocks and only the first A_j of
+ * every segment (the checkpoint) is kept during the elimination. Going
+ * outward, the other s-1 matrices of a segment are recomputed from the
+ * checkpoint of the next segment, used and released.
+ *
+ *   memory:    numCheckpoints + s - 1 matrices per side
+ *   recompute: n - numCheckpoints blocks per side
+ *
+ * numCheckpoints = sqrt(n) gives about 2*sqrt(n) matrices for one extra
+ * recursion; numCheckpoints = n keeps everything and recomputes nothing.
+ * Nothing is written to the disk.
+ */
+
+#ifndef CHECKPOINTRECURSION_H_
+#define CHECKPOINTRECURSION_H_
+
+#include "segmentedRecursion.h"
+
+
+/**
+ * the length of the segments for numCheckpoints checkpoints among numBlocks
+ * blocks (numCheckpoints <= 0 picks sqrt(numBlocks))
+ */
+int checkpointInterval(int numBlocks, int numCheckpoints);
+
+/**
+ * the recursion of one side; checkpoints[t] = A_{t*interval}, so that
+ * checkpoints[0] is A_{KRightStop} (ATilde_{KLeftStop} on the left side)
+ */
+void eliminateChainCheckpointed(const BlockChain& chain, dcomplex z, int interval,
+		                        std::vector<CDMatrix>& checkpoints);
+
+/**
+ * V_j = A_j*V_{j-1} from V_{-1} = VKCenter for the first numUsed blocks,
+ * recomputing the A_j between the checkpoints (which are released on the
+ * way); the V_j are put into gf with assignValuesToG. Returns the number
+ * of recomputed blocks.
+ */
+int propagateChainCheckpointed(LatticeShape& lattice, const BlockChain& chain,
+		                       dcomplex z, int interval, int numUsed,
+		                       std::vector<CDMatrix>& checkpoints,
+		                       const CDMatrix& VKCenter, CDMatrix& gf);
+
+/**
+ * same as calculateAllGreenFunc with numCheckpoints checkpoints on each side
+ * (<= 0 picks sqrt of the number of blocks)
+ *
+ * IMPORTANT: before calling calculateAllGreenFuncCheckpointed, you have to
+ *            call setUpIndexInteractions(lattice, interactionData)
+ */
+void calculateAllGreenFuncCheckpointed(LatticeShape& lattice, Basis& initialSites,
+		                               InteractionData& interactionData,
+		                               const std::vector<dcomplex>& zList,
+		                               const std::vector<std::string>& fileList,
+		                               int numCheckpoints);
+
+#endif /* CHECKPOINTRECURSION_H_ */
@@ -0,0 +1,64 @@
+/*
+ * checkpointRecursion_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "checkpointRecursion.h"
+#include "../IO/binaryIO.h"
+
+
+TEST(CheckpointInterval, MemoryAgainstRecompute) {
+	EXPECT_EQ(checkpointInterval(100, 0), 10);
+	EXPECT_EQ(checkpointInterval(10, 3), 4);
+	EXPECT_EQ(checkpointInterval(10, 10), 1);
+	EXPECT_EQ(checkpointInterval(10, 50), 1);
+	EXPECT_EQ(checkpointInterval(10, 1), 10);
+}
+
+
+TEST(CalculateAllGreenFuncCheckpointed, SameAsCalculateAllGreenFunc) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(40);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,3,23,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(15, 18);
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.3, 0.1));
+	std::vector<std::string> files;
+	files.push_back("checkpoint_test_all.bin");
+	calculateAllGreenFunc(lattice1D, initialSites, interactionData, zList, files);
+	CDMatrix gfAll;
+	loadMatrixBin(files[0], gfAll);
+	remove(files[0].c_str());
+
+	int numCheckpointsList[4] = {1, 0, 4, 1000};
+	for (int i=0; i<4; ++i) {
+		files[0] = "checkpoint_test_" + itos(i) + ".bin";
+		calculateAllGreenFuncCheckpointed(lattice1D, initialSites, interactionData,
+				                          zList, files, numCheckpointsList[i]);
+		CDMatrix gf;
+		loadMatrixBin(files[0], gf);
+		remove(files[0].c_str());
+		EXPECT_LT((gf-gfAll).norm(), 1e-12*gfAll.norm());
+	}
+
+	// one checkpoint per block: nothing is recomputed
+	RecursionData recursionData;
+	setUpRecursion(lattice1D, interactionData, initialSites, recursionData);
+	BlockChain chain = rightChain(recursionData);
+	CDMatrix gf = CDMatrix::Zero(41, 41);
+	std::vector<CDMatrix> checkpoints;
+	int n = chain.numBlocks;
+	eliminateChainCheckpointed(chain, zList[0], 1, checkpoints);
+	EXPECT_EQ(checkpoints.size(), n);
+	CDMatrix VKCenter = CDMatrix::Ones(checkpoints[0].cols(), 1);
+	EXPECT_EQ(propagateChainCheckpointed(lattice1D, chain, zList[0], 1, n,
+			                             checkpoints, VKCenter, gf), 0);
+	int interval = checkpointInterval(n, 0);
+	eliminateChainCheckpointed(chain, zList[0], interval, checkpoints);
+	EXPECT_EQ(propagateChainCheckpointed(lattice1D, chain, zList[0], interval, n,
+			                             checkpoints, VKCenter, gf), n - checkpoints.size());
+}
@@ -0,0 +1,339 @@
+/*
+ * hodlr.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "hodlr.h"
+#include "bandedSolver.h"
+#include "symmetricSolver.h"
+
+
+/**
+ * B = U*V^T up to a residual with |R|_F^2 <= maxError2, or B itself if
+ * that needs a rank for which U and V are larger than B
+ */
+static void crossApproximation(const CDMatrix& B, double maxError2, LowRankBlock& block) {
+	int m = B.rows();
+	int n = B.cols();
+	int maxRank = (m*n)/(m+n);
+	CDMatrix R = B;
+	std::vector<CDVector> us, vs;
+	while (R.squaredNorm() > maxError2 && us.size() < maxRank) {
+		int i, j;
+		R.cwiseAbs2().maxCoeff(&i, &j);
+		CDVector u = R.col(j);
+		CDVector v = R.row(i).transpose()/R(i, j);
+		R.noalias() -= u*v.transpose();
+		us.push_back(u);
+		vs.push_back(v);
+	}
+	block.dense = R.squaredNorm() > maxError2;
+	if (block.dense) {
+		block.U = B;
+		block.V.resize(0,0);
+		return;
+	}
+	int rank = us.size();
+	block.U.resize(m, rank);
+	block.V.resize(n, rank);
+	for (int k=0; k<rank; ++k) {
+		block.U.col(k) = us[k];
+		block.V.col(k) = vs[k];
+	}
+}
+
+
+/**
+ * errorPerEntry2*rows*cols is the squared error allowed in this block, so
+ * that the errors of all the blocks add up to at most tolerance^2*|A|_F^2
+ */
+static void compressBlock(const CDMatrix& B, int leafSize, double errorPerEntry2,
+		                  HODLRBlock& block) {
+	block.rows = B.rows();
+	block.cols = B.cols();
+	if (min(block.rows, block.cols) < 2*leafSize) {
+		block.dense = B;
+		return;
+	}
+	int r1 = block.rows/2;
+	int c1 = block.cols/2;
+	int r2 = block.rows - r1;
+	int c2 = block.cols - c1;
+	block.diagonal.resize(2);
+	compressBlock(B.topLeftCorner(r1, c1), leafSize, errorPerEntry2, block.diagonal[0]);
+	compressBlock(B.bottomRightCorner(r2, c2), leafSize, errorPerEntry2, block.diagonal[1]);
+	crossApproximation(B.topRightCorner(r1, c2), errorPerEntry2*r1*c2, block.upper);
+	crossApproximation(B.bottomLeftCorner(r2, c1), errorPerEntry2*r2*c1, block.lower);
+}
+
+
+void compressHODLR(const CDMatrix& A, const std::vector<int>& rowOrder,
+		           const std::vector<int>& colOrder, const CompressionData& data,
+		           HODLRMatrix& H) {
+	PROFILE_SCOPE("compressHODLR");
+	H.rowOrder = rowOrder;
+	H.colOrder = colOrder;
+	CDMatrix P = A;
+	if (!rowOrder.empty()) {
+		for (int i=0; i<A.rows(); ++i) P.row(i) = A.row(rowOrder[i]);
+	}
+	if (!colOrder.empty()) {
+		CDMatrix PRows = P;
+		for (int j=0; j<A.cols(); ++j) P.col(j) = PRows.col(colOrder[j]);
+	}
+	double errorPerEntry2 = data.tolerance*data.tolerance*A.squaredNorm()
+			                / std::max(1.0, double(A.rows())*A.cols());
+	H.root.diagonal.clear();
+	compressBlock(P, data.leafSize, errorPerEntry2, H.root);
+}
+
+
+/**
+ * Y = L*X for an off-diagonal block
+ */
+static CDMatrix lowRankTimes(const LowRankBlock& L, const CDMatrix& X) {
+	if (L.dense) return L.U*X;
+	return L.U*(L.V.transpose()*X);
+}
+
+
+/**
+ * Y = X*L for an off-diagonal block
+ */
+static CDMatrix timesLowRank(const CDMatrix& X, const LowRankBlock& L) {
+	if (L.dense) return X*L.U;
+	return (X*L.U)*L.V.transpose();
+}
+
+
+static void multiplyBlock(const HODLRBlock& block, const CDMatrix& X, CDMatrix& Y) {
+	if (block.diagonal.empty()) {
+		Y.noalias() = block.dense*X;
+		return;
+	}
+	int c1 = block.diagonal[0].cols;
+	int c2 = block.diagonal[1].cols;
+	CDMatrix X1 = X.topRows(c1);
+	CDMatrix X2 = X.bottomRows(c2);
+	CDMatrix Y1, Y2;
+	multiplyBlock(block.diagonal[0], X1, Y1);
+	multiplyBlock(block.diagonal[1], X2, Y2);
+	Y1 += lowRankTimes(block.upper, X2);
+	Y2 += lowRankTimes(block.lower, X1);
+	Y.resize(block.rows, X.cols());
+	Y << Y1, Y2;
+}
+
+
+static void multiplyBlockLeft(const CDMatrix& X, const HODLRBlock& block, CDMatrix& Y) {
+	if (block.diagonal.empty()) {
+		Y.noalias() = X*block.dense;
+		return;
+	}
+	int r1 = block.diagonal[0].rows;
+	int r2 = block.diagonal[1].rows;
+	CDMatrix X1 = X.leftCols(r1);
+	CDMatrix X2 = X.rightCols(r2);
+	CDMatrix Y1, Y2;
+	multiplyBlockLeft(X1, block.diagonal[0], Y1);
+	multiplyBlockLeft(X2, block.diagonal[1], Y2);
+	Y1 += timesLowRank(X2, block.lower);
+	Y2 += timesLowRank(X1, block.upper);
+	Y.resize(X.rows(), block.cols);
+	Y << Y1, Y2;
+}
+
+
+void multiplyHODLR(const HODLRMatrix& H, const CDMatrix& X, CDMatrix& Y) {
+	PROFILE_SCOPE("multiplyHODLR");
+	CDMatrix XOrdered = X;
+	if (!H.colOrder.empty()) {
+		for (int j=0; j<X.rows(); ++j) XOrdered.row(j) = X.row(H.colOrder[j]);
+	}
+	CDMatrix YOrdered;
+	multiplyBlock(H.root, XOrdered, YOrdered);
+	if (H.rowOrder.empty()) {
+		Y.swap(YOrdered);
+		return;
+	}
+	Y.resize(YOrdered.rows(), YOrdered.cols());
+	for (int i=0; i<YOrdered.rows(); ++i) Y.row(H.rowOrder[i]) = YOrdered.row(i);
+}
+
+
+void multiplyLeftHODLR(const CDMatrix& X, const HODLRMatrix& H, CDMatrix& Y) {
+	PROFILE_SCOPE("multiplyHODLR");
+	CDMatrix XOrdered = X;
+	if (!H.rowOrder.empty()) {
+		for (int i=0; i<X.cols(); ++i) XOrdered.col(i) = X.col(H.rowOrder[i]);
+	}
+	CDMatrix YOrdered;
+	multiplyBlockLeft(XOrdered, H.root, YOrdered);
+	if (H.colOrder.empty()) {
+		Y.swap(YOrdered);
+		return;
+	}
+	Y.resize(YOrdered.rows(), YOrdered.cols());
+	for (int j=0; j<YOrdered.cols(); ++j) Y.col(H.colOrder[j]) = YOrdered.col(j);
+}
+
+
+void expandHODLR(const HODLRMatrix& H, CDMatrix& A) {
+	// the columns of H*I
+	CDMatrix identity = CDMatrix::Identity(H.root.cols, H.root.cols);
+	multiplyHODLR(H, identity, A);
+}
+
+
+static long blockEntries(const HODLRBlock& block) {
+	if (block.diagonal.empty()) return block.dense.size();
+	return blockEntries(block.diagonal[0]) + blockEntries(block.diagonal[1])
+		   + block.upper.U.size() + block.upper.V.size()
+		   + block.lower.U.size() + block.lower.V.size();
+}
+
+
+long storedEntries(const HODLRMatrix& H) {
+	return blockEntries(H.root);
+}
+
+
+/**
+ * the site ordering of V_K, or the identity if V_K does not have size rows
+ * (the column block of A_0 on the left side, see leftChain)
+ */
+static void blockOrdering(int K, int maxDistance, int size, std::vector<int>& order) {
+	siteOrdering(K, maxDistance, order);
+	if (order.size() != size) order.clear();
+}
+
+
+void eliminateChainCompressed(const BlockChain& chain, dcomplex z,
+		                      const CompressionData& data, int numKept,
+		                      std::vector<HODLRMatrix>& blocks, CDMatrix& AFirst) {
+	PROFILE_SCOPE("eliminateChainCompressed");
+	int n = chain.numBlocks;
+	int maxDistance = std::abs(chain.step);
+	blocks.clear();
+	blocks.resize(n);
+	CDMatrix A;
+	for (int j=n-1; j>=0; --j) {
+		int K = chain.K0 + j*chain.step;
+		CDMatrix W, inner, outer;
+		formChainBlocks(chain, j, z, W, inner, outer);
+		if (j == n-1) {
+			solveBlockLinearEqs(K, maxDistance, W, inner, A);
+		} else {
+			CDMatrix outerA;
+			multiplyLeftHODLR(outer, blocks[j+1], outerA);
+			if (j+1 >= numKept) blocks[j+1] = HODLRMatrix();
+			W -= outerA;
+			solveSymmetricLinearEqs(W, inner, A);
+		}
+		std::vector<int> rowOrder, colOrder;
+		blockOrdering(K, maxDistance, A.rows(), rowOrder);
+		blockOrdering(K-chain.step, maxDistance, A.cols(), colOrder);
+		compressHODLR(A, rowOrder, colOrder, data, blocks[j]);
+	}
+	if (numKept < 1) blocks[0] = HODLRMatrix();
+	AFirst.swap(A);
+}
+
+
+void calculateGreenFuncCompressed(LatticeShape& lattice, Basis& finalSites,
+		                          Basis& initialSites,
+		                          InteractionData& interactionData,
+		                          const std::vector<dcomplex>& zList,
+		                          const CompressionData& data,
+		                          std::vector<dcomplex>& gfList) {
+	RecursionData recursionData;
+	setUpRecursion(lattice, interactionData, initialSites, recursionData);
+
+	int maxDistance = interactionData.maxDistance;
+	int Kinitial = recursionData.KCenter;
+	int Kfinal = findCorrespondingVK(lattice, maxDistance, finalSites);
+	int rowIndex = getBasisIndexInVK(lattice, Kfinal, finalSites);
+
+	BlockChain left = leftChain(recursionData);
+	BlockChain right = rightChain(recursionData);
+	// the blocks from V_{KCenter} to V_{Kfinal}
+	int numLeft = (Kfinal<Kinitial) ? (Kfinal-left.K0)/left.step + 1 : 0;
+	int numRight = (Kfinal>Kinitial) ? (Kfinal-right.K0)/right.step + 1 : 0;
+
+	gfList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		dcomplex z = zList[i];
+		std::vector<HODLRMatrix> leftBlocks, rightBlocks;
+		CDMatrix ATildeKLeftStop, AKRightStop;
+		eliminateChainCompressed(left, z, data, numLeft, leftBlocks, ATildeKLeftStop);
+		eliminateChainCompressed(right, z, data, numRight, rightBlocks, AKRightStop);
+
+		CDMatrix VKfinal;
+		solveVKCenter(recursionData, z, ATildeKLeftStop, AKRightStop, VKfinal);
+		for (int j=0; j<numRight; ++j) {
+			CDMatrix VK;
+			multiplyHODLR(rightBlocks[j], VKfinal, VK);
+			VKfinal.swap(VK);
+		}
+		for (int j=0; j<numLeft; ++j) {
+			CDMatrix VK;
+			multiplyHODLR(leftBlocks[j], VKfinal, VK);
+			VKfinal.swap(VK);
+		}
+		gfList.push_back(VKfinal(rowIndex, 0));
+	}
+}
+
+
+void calculateAllGreenFuncCompressed(LatticeShape& lattice, Basis& initialSites,
+		                             InteractionData& interactionData,
+		                             const std::vector<dcomplex>& zList,
+		                             const std::vector<std::string>& fileList,
+		                             const CompressionData& data) {
+	// for the 1D case, the index for a site = the label of the site
+	int nsite = lattice.getXmax()+1;
+	CDMatrix gf = CDMatrix::Zero(nsite, nsite);
+
+	int maxDistance = interactionData.maxDistance;
+	RecursionData recursionData;
+	setUpRecursion(lattice, interactionData, initialSites, recursionData);
+	BlockChain right = rightChain(recursionData);
+	BlockChain left = leftChain(recursionData);
+	// the blocks that calculateAllGreenFunc goes through from V_{KCenter}
+	int rightUsed = recursionData.KRightStart>=recursionData.KRightStop ? right.numBlocks : 0;
+	int leftUsed = recursionData.KLeftStop>=recursionData.KLeftStart ? left.numBlocks : 0;
+
+	for (int i=0; i<zList.size(); ++i) {
+		dcomplex z = zList[i];
+		std::vector<HODLRMatrix> rightBlocks, leftBlocks;
+		CDMatrix AKRightStop, ATildeKLeftStop;
+		eliminateChainCompressed(right, z, data, rightUsed, rightBlocks, AKRightStop);
+		eliminateChainCompressed(left, z, data, leftUsed, leftBlocks, ATildeKLeftStop);
+
+		CDMatrix VKCenter;
+		solveVKCenter(recursionData, z, ATildeKLeftStop, AKRightStop, VKCenter);
+		assignValuesToG(lattice, recursionData.KCenter, maxDistance, VKCenter, gf);
+
+		CDMatrix VK = VKCenter;
+		for (int j=0; j<rightUsed; ++j) {
+			CDMatrix VNext;
+			multiplyHODLR(rightBlocks[j], VK, VNext);
+			VK.swap(VNext);
+			rightBlocks[j] = HODLRMatrix();
+			assignValuesToG(lattice, right.K0+j*right.step, maxDistance, VK, gf);
+		}
+		VK = VKCenter;
+		for (int j=0; j<leftUsed; ++j) {
+			CDMatrix VNext;
+			multiplyHODLR(leftBlocks[j], VK, VNext);
+			VK.swap(VNext);
+			leftBlocks[j] = HODLRMatrix();
+			assignValuesToG(lattice, left.K0+j*left.step, maxDistance, VK, gf);
+		}
+
+		PROFILE_SCOPE("output");
+		saveMatrix(fileList[i], gf);
+	}
+}
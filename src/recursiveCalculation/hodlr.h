@@ -0,0 +1,129 @@
+/*
+ * hodlr.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Hierarchically off-diagonal low-rank (HODLR) form of the A_K and ATilde_K
+ * matrices.
+ *
+ * With disorder or a finite eta, V_K = A_K*V_{K-maxDistance} couples sites
+ * that are far apart only weakly. With the rows and columns sorted by x1
+ * (siteOrdering of bandedSolver.h) the off-diagonal blocks of A_K have a
+ * small numerical rank, e.g. about 25 at 1e-6 for 150 x 150 blocks and
+ * nearly independent of xmax; in the original ordering they are full rank.
+ *
+ * The permuted matrix is split into 2 x 2 blocks, the two diagonal blocks
+ * recursively and the two off-diagonal blocks as U*V^T, built by adaptive
+ * cross approximation: the largest element of the residual is the next
+ * pivot and its row and column are the next rank-1 term. A_K is formed
+ * densely anyway, so the residual is available and the error is exact:
+ *
+ *   |H - A|_F <= tolerance*|A|_F
+ *
+ * The products H*X and X*H then cost O(k*n*r*log(n)) instead of O(k*n^2),
+ * and the storage is O(n*r*log(n)).
+ */
+
+#ifndef HODLR_H_
+#define HODLR_H_
+
+#include "segmentedRecursion.h"
+
+
+typedef struct {
+	double tolerance;  // relative to the Frobenius norm of the whole matrix
+	int leafSize;      // blocks with fewer rows or columns are kept dense
+} CompressionData;
+
+
+/**
+ * an off-diagonal block U*V^T, or U itself if it is not worth compressing
+ */
+typedef struct {
+	CDMatrix U, V;
+	bool dense;
+} LowRankBlock;
+
+
+/**
+ * a dense leaf, or two diagonal blocks (again HODLR) and two low-rank
+ * off-diagonal blocks: [diagonal[0], upper; lower, diagonal[1]]
+ */
+struct HODLRBlock {
+	int rows, cols;
+	CDMatrix dense;
+	std::vector<HODLRBlock> diagonal;
+	LowRankBlock upper, lower;
+};
+
+
+typedef struct {
+	// row i (column j) of root is row rowOrder[i] (column colOrder[j]) of the matrix
+	std::vector<int> rowOrder, colOrder;
+	HODLRBlock root;
+} HODLRMatrix;
+
+
+/**
+ * the HODLR form of A(rowOrder[i], colOrder[j]); an empty order is the identity
+ */
+void compressHODLR(const CDMatrix& A, const std::vector<int>& rowOrder,
+		           const std::vector<int>& colOrder, const CompressionData& data,
+		           HODLRMatrix& H);
+
+/**
+ * Y = H*X
+ */
+void multiplyHODLR(const HODLRMatrix& H, const CDMatrix& X, CDMatrix& Y);
+
+/**
+ * Y = X*H
+ */
+void multiplyLeftHODLR(const CDMatrix& X, const HODLRMatrix& H, CDMatrix& Y);
+
+/**
+ * the dense matrix
+ */
+void expandHODLR(const HODLRMatrix& H, CDMatrix& A);
+
+/**
+ * the number of complex numbers stored
+ */
+long storedEntries(const HODLRMatrix& H);
+
+
+/**
+ * the recursion of one side (see segmentedRecursion.h) with
+ * outer_j*A_{j+1} on the compressed A_{j+1}; blocks[j] is the compressed
+ * A_j for j < numKept (the others are released), AFirst the dense A_0
+ */
+void eliminateChainCompressed(const BlockChain& chain, dcomplex z,
+		                      const CompressionData& data, int numKept,
+		                      std::vector<HODLRMatrix>& blocks, CDMatrix& AFirst);
+
+/**
+ * same as calculateGreenFunc with the A (ATilde) matrices kept compressed
+ * in memory; nothing is written to the disk
+ *
+ * IMPORTANT: before calling calculateGreenFuncCompressed, you have to call
+ *            setUpIndexInteractions(lattice, interactionData)
+ */
+void calculateGreenFuncCompressed(LatticeShape& lattice, Basis& finalSites,
+		                          Basis& initialSites,
+		                          InteractionData& interactionData,
+		                          const std::vector<dcomplex>& zList,
+		                          const CompressionData& data,
+		                          std::vector<dcomplex>& gfList);
+
+/**
+ * same as calculateAllGreenFunc with the A and ATilde matrices kept
+ * compressed in memory instead of on the disk
+ */
+void calculateAllGreenFuncCompressed(LatticeShape& lattice, Basis& initialSites,
+		                             InteractionData& interactionData,
+		                             const std::vector<dcomplex>& zList,
+		                             const std::vector<std::string>& fileList,
+		                             const CompressionData& data);
+
+#endif /* HODLR_H_ */
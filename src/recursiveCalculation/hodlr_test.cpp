@@ -0,0 +1,88 @@
+/*
+ * hodlr_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "hodlr.h"
+#include "bandedSolver.h"
+#include "../IO/binaryIO.h"
+
+
+TEST(HODLR, CompressA) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(100);
+	int maxDistance = 3;
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,maxDistance,23,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(50, 51);
+	RecursionData recursionData;
+	setUpRecursion(lattice1D, interactionData, initialSites, recursionData);
+	BlockChain chain = rightChain(recursionData);
+	std::vector<HODLRMatrix> blocks;
+	CDMatrix A;
+	CompressionData data = {1e-8, 16};
+	eliminateChainCompressed(chain, dcomplex(0.3, 0.1), data, 0, blocks, A);
+	EXPECT_EQ(storedEntries(blocks[0]), 0);
+
+	std::vector<int> rowOrder, colOrder;
+	siteOrdering(chain.K0, maxDistance, rowOrder);
+	siteOrdering(chain.K0-maxDistance, maxDistance, colOrder);
+	HODLRMatrix H;
+	compressHODLR(A, rowOrder, colOrder, data, H);
+	EXPECT_LT(storedEntries(H), A.size());
+	CDMatrix AExpanded;
+	expandHODLR(H, AExpanded);
+	EXPECT_LE((AExpanded-A).norm(), 1e-8*A.norm());
+
+	CDMatrix X = CDMatrix::Random(A.cols(), 2);
+	CDMatrix Y;
+	multiplyHODLR(H, X, Y);
+	EXPECT_LT((Y-A*X).norm(), 1e-7*(A*X).norm());
+	CDMatrix XLeft = CDMatrix::Random(3, A.rows());
+	multiplyLeftHODLR(XLeft, H, Y);
+	EXPECT_LT((Y-XLeft*A).norm(), 1e-7*(XLeft*A).norm());
+
+	// a tolerance of 0 keeps A
+	data.tolerance = 0.0;
+	compressHODLR(A, rowOrder, colOrder, data, H);
+	expandHODLR(H, AExpanded);
+	EXPECT_LT((AExpanded-A).norm(), 1e-13*A.norm());
+}
+
+
+TEST(HODLR, SameAsCalculateGreenFunc) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(60);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,3,23,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(25, 28);
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.3, 0.1));
+	CompressionData data = {1e-10, 16};
+
+	Basis finalSitesList[2] = {Basis(40, 55), Basis(2, 9)};
+	for (int i=0; i<2; ++i) {
+		std::vector<dcomplex> gf, gfCompressed;
+		calculateGreenFunc(lattice1D, finalSitesList[i], initialSites, interactionData, zList, gf);
+		calculateGreenFuncCompressed(lattice1D, finalSitesList[i], initialSites,
+				                     interactionData, zList, data, gfCompressed);
+		EXPECT_LT(std::abs(gfCompressed[0]-gf[0]), 1e-8*std::abs(gf[0]));
+	}
+	deleteMatrixFiles("A*.bin");
+
+	std::vector<std::string> files;
+	files.push_back("hodlr_test_all.bin");
+	calculateAllGreenFunc(lattice1D, initialSites, interactionData, zList, files);
+	CDMatrix gfAll;
+	loadMatrixBin(files[0], gfAll);
+	files[0] = "hodlr_test_compressed.bin";
+	calculateAllGreenFuncCompressed(lattice1D, initialSites, interactionData, zList, files, data);
+	CDMatrix gfCompressed;
+	loadMatrixBin(files[0], gfCompressed);
+	EXPECT_LT((gfCompressed-gfAll).norm(), 1e-8*gfAll.norm());
+	remove("hodlr_test_all.bin");
+	remove("hodlr_test_compressed.bin");
+}
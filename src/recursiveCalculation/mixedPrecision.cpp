@@ -0,0 +1,235 @@
+/*
+ * mixedPrecision.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "mixedPrecision.h"
+
+
+static int blockK(MixedFactorization& factorization, int i) {
+	return factorization.KFirst + i*factorization.maxDistance;
+}
+
+
+/**
+ * alpha_i*X in single precision (the first block has no alpha)
+ */
+static CFMatrix alphaTimes(MixedFactorization& factorization, int i, const CFMatrix& X) {
+	CDMatrix alpha;
+	formMatrixAlpha(blockK(factorization, i), alpha);
+	return alpha.cast<fcomplex>()*X;
+}
+
+
+/**
+ * beta_i*X in single precision (the last block has no beta)
+ */
+static CFMatrix betaTimes(MixedFactorization& factorization, int i, const CFMatrix& X) {
+	CDMatrix beta;
+	formMatrixBeta(blockK(factorization, i), beta);
+	return beta.cast<fcomplex>()*X;
+}
+
+
+void factorizeMixed(RecursionData& recursionData, dcomplex z,
+		            MixedFactorization& factorization) {
+	PROFILE_SCOPE("factorizeMixed");
+	int maxDistance = recursionData.maxDistance;
+	factorization.KFirst = recursionData.KLeftStart;
+	factorization.maxDistance = maxDistance;
+	factorization.numBlocks = (recursionData.KRightStart-recursionData.KLeftStart)/maxDistance + 1;
+	factorization.center = (recursionData.KCenter-recursionData.KLeftStart)/maxDistance;
+	int N = factorization.numBlocks;
+	int c = factorization.center;
+	factorization.factors.clear();
+	factorization.factors.resize(N);
+
+	// from the right: M_i = W_i - beta_i*A_{i+1}, A_i = M_i^{-1}*alpha_i
+	CFMatrix APlus;
+	for (int i=N-1; i>c; --i) {
+		CDMatrix W, alpha;
+		formMatrixW(blockK(factorization, i), z, W);
+		CFMatrix M = W.cast<fcomplex>();
+		if (i<N-1) M.noalias() -= betaTimes(factorization, i, APlus);
+		factorization.factors[i].compute(M);
+		formMatrixAlpha(blockK(factorization, i), alpha);
+		APlus = factorization.factors[i].solve(alpha.cast<fcomplex>());
+	}
+
+	// from the left: M_i = W_i - alpha_i*ATilde_{i-1}, ATilde_i = M_i^{-1}*beta_i
+	CFMatrix ATildeMinus;
+	for (int i=0; i<c; ++i) {
+		CDMatrix W, beta;
+		formMatrixW(blockK(factorization, i), z, W);
+		CFMatrix M = W.cast<fcomplex>();
+		if (i>0) M.noalias() -= alphaTimes(factorization, i, ATildeMinus);
+		factorization.factors[i].compute(M);
+		formMatrixBeta(blockK(factorization, i), beta);
+		ATildeMinus = factorization.factors[i].solve(beta.cast<fcomplex>());
+	}
+
+	CDMatrix W;
+	formMatrixW(blockK(factorization, c), z, W);
+	CFMatrix M = W.cast<fcomplex>();
+	if (c>0) M.noalias() -= alphaTimes(factorization, c, ATildeMinus);
+	if (c<N-1) M.noalias() -= betaTimes(factorization, c, APlus);
+	factorization.factors[c].compute(M);
+}
+
+
+void solveMixed(MixedFactorization& factorization,
+		        std::vector<CDMatrix>& R, std::vector<CDMatrix>& V) {
+	PROFILE_SCOPE("solveMixed");
+	int N = factorization.numBlocks;
+	int c = factorization.center;
+	std::vector<CFMatrix> y(N);
+	for (int i=N-1; i>c; --i) {
+		CFMatrix rightSide = R[i].cast<fcomplex>();
+		if (i<N-1) rightSide += betaTimes(factorization, i, y[i+1]);
+		y[i] = factorization.factors[i].solve(rightSide);
+	}
+	for (int i=0; i<c; ++i) {
+		CFMatrix rightSide = R[i].cast<fcomplex>();
+		if (i>0) rightSide += alphaTimes(factorization, i, y[i-1]);
+		y[i] = factorization.factors[i].solve(rightSide);
+	}
+
+	CFMatrix rightSide = R[c].cast<fcomplex>();
+	if (c>0) rightSide += alphaTimes(factorization, c, y[c-1]);
+	if (c<N-1) rightSide += betaTimes(factorization, c, y[c+1]);
+	y[c] = factorization.factors[c].solve(rightSide);
+
+	// V_i = y_i + M_i^{-1}*alpha_i*V_{i-1} on the right, the same with beta on the left
+	for (int i=c+1; i<N; ++i) {
+		y[i] += factorization.factors[i].solve(alphaTimes(factorization, i, y[i-1]));
+	}
+	for (int i=c-1; i>=0; --i) {
+		y[i] += factorization.factors[i].solve(betaTimes(factorization, i, y[i+1]));
+	}
+
+	V.resize(N);
+	for (int i=0; i<N; ++i) {
+		V[i] = y[i].cast<dcomplex>();
+	}
+}
+
+
+void multiplyMixed(MixedFactorization& factorization, dcomplex z,
+		           std::vector<CDMatrix>& V, std::vector<CDMatrix>& HV) {
+	PROFILE_SCOPE("multiplyMixed");
+	int N = factorization.numBlocks;
+	HV.resize(N);
+	for (int i=0; i<N; ++i) {
+		int K = blockK(factorization, i);
+		CDMatrix W;
+		formMatrixW(K, z, W);
+		HV[i].noalias() = W*V[i];
+		if (i>0) {
+			CDMatrix alpha;
+			formMatrixAlpha(K, alpha);
+			HV[i].noalias() -= alpha*V[i-1];
+		}
+		if (i<N-1) {
+			CDMatrix beta;
+			formMatrixBeta(K, beta);
+			HV[i].noalias() -= beta*V[i+1];
+		}
+	}
+}
+
+
+/**
+ * R = C - H*V in double precision; the norm of R is returned
+ */
+static double residualMixed(MixedFactorization& factorization, dcomplex z,
+		                    std::vector<CDMatrix>& C, std::vector<CDMatrix>& V,
+		                    std::vector<CDMatrix>& R) {
+	multiplyMixed(factorization, z, V, R);
+	double norm2 = 0.0;
+	for (int i=0; i<R.size(); ++i) {
+		R[i] = C[i] - R[i];
+		norm2 += R[i].squaredNorm();
+	}
+	return std::sqrt(norm2);
+}
+
+
+int solveMixedRefined(RecursionData& recursionData, dcomplex z,
+		              RefinementData& refinementData,
+		              std::vector<CDMatrix>& V, double& residual) {
+	MixedFactorization factorization;
+	factorizeMixed(recursionData, z, factorization);
+	int N = factorization.numBlocks;
+	int c = factorization.center;
+
+	// C is zero except one element of the center block (|C| = 1)
+	std::vector<CDMatrix> C(N);
+	for (int i=0; i<N; ++i) {
+		C[i] = CDMatrix::Zero(factorization.factors[i].rows(), 1);
+	}
+	C[c](recursionData.indexForNonzero, 0) = dcomplex(1.0, 0.0);
+
+	solveMixed(factorization, C, V);
+	std::vector<CDMatrix> R;
+	residual = residualMixed(factorization, z, C, V, R);
+	int iteration = 0;
+	while (residual > refinementData.tolerance && iteration < refinementData.maxIterations) {
+		std::vector<CDMatrix> correction;
+		solveMixed(factorization, R, correction);
+		for (int i=0; i<N; ++i) {
+			V[i] += correction[i];
+		}
+		residual = residualMixed(factorization, z, C, V, R);
+		++iteration;
+	}
+	return iteration;
+}
+
+
+void calculateGreenFuncMixed(LatticeShape& lattice, Basis& finalSites,
+		                     Basis& initialSites,
+		                     InteractionData& interactionData,
+		                     const std::vector<dcomplex>& zList,
+		                     RefinementData& refinementData,
+		                     std::vector<dcomplex>& gfList,
+		                     std::vector<double>& residualList) {
+	RecursionData recursionData;
+	setUpRecursion(lattice, interactionData, initialSites, recursionData);
+
+	int maxDistance = interactionData.maxDistance;
+	int Kfinal = findCorrespondingVK(lattice, maxDistance, finalSites);
+	int rowIndex = getBasisIndexInVK(lattice, Kfinal, finalSites);
+	int finalBlock = (Kfinal-recursionData.KLeftStart)/maxDistance;
+
+	gfList.clear();
+	residualList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		std::vector<CDMatrix> V;
+		double residual;
+		solveMixedRefined(recursionData, zList[i], refinementData, V, residual);
+		gfList.push_back(V[finalBlock](rowIndex, 0));
+		residualList.push_back(residual);
+	}
+}
+
+
+double mixedPrecisionDeviation(LatticeShape& lattice, Basis& finalSites,
+		                       Basis& initialSites,
+		                       InteractionData& interactionData,
+		                       const std::vector<dcomplex>& zList,
+		                       RefinementData& refinementData) {
+	std::vector<dcomplex> gfDouble, gfMixed;
+	std::vector<double> residualList;
+	calculateGreenFunc(lattice, finalSites, initialSites, interactionData,
+			zList, gfDouble);
+	calculateGreenFuncMixed(lattice, finalSites, initialSites, interactionData,
+			zList, refinementData, gfMixed, residualList);
+	double deviation = 0.0;
+	for (int i=0; i<zList.size(); ++i) {
+		deviation = std::max(deviation,
+				std::abs(gfMixed[i]-gfDouble[i])/std::abs(gfDouble[i]));
+	}
+	return deviation;
+}
@@ -0,0 +1,108 @@
+/*
+ * mixedPrecision.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * The recursion in single precision with iterative refinement.
+ *
+ * With the blocks i = 0, 1, ..., N-1 of K = KLeftStart + i*maxDistance
+ * (block c is V_{KCenter}), the whole system H*V = C reads
+ *
+ *   W_i*V_i - alpha_i*V_{i-1} - beta_i*V_{i+1} = C_i
+ *
+ * The matrices M_i of the two recursions (W - beta*A_{+} on the right,
+ * W - alpha*ATilde_{-} on the left, and the center matrix of solveVKCenter)
+ * are formed and factorized in complex<float>. Together they solve H*V = R
+ * for any R:
+ *
+ *   y_i = M_i^{-1}*(R_i + beta_i*y_{i+1})             (i > c)
+ *   V_i = y_i + M_i^{-1}*alpha_i*V_{i-1}
+ *
+ * and the same on the left. This is only accurate to single precision, so
+ * the solution is refined against the operators in double precision:
+ *
+ *   R = C - H*V,   V += H_float^{-1}*R
+ *
+ * until |R|/|C| < tolerance. Each refinement step costs O(N*n^2), against
+ * O(N*n^3) for the factorization.
+ *
+ * The factors of all the blocks stay in memory (in single precision they
+ * take half the size of the A matrices that the double path writes to disk).
+ */
+
+#ifndef MIXEDPRECISION_H_
+#define MIXEDPRECISION_H_
+
+#include "recursiveCalculation.h"
+
+
+typedef struct {
+	int maxIterations; // of the refinement
+	double tolerance;  // on the relative residual |C - H*V|/|C|
+} RefinementData;
+
+
+typedef struct {
+	int KFirst;     // KLeftStart
+	int numBlocks;  // N
+	int center;     // c
+	int maxDistance;
+	std::vector< Eigen::PartialPivLU<CFMatrix> > factors; // of M_i
+} MixedFactorization;
+
+
+/**
+ * factorize M_i in single precision for all the blocks of the recursion
+ */
+void factorizeMixed(RecursionData& recursionData, dcomplex z,
+		            MixedFactorization& factorization);
+
+/**
+ * V = H^{-1}*R with the single-precision factors (at the energy of
+ * factorizeMixed); R and V have one block per block of the recursion
+ */
+void solveMixed(MixedFactorization& factorization,
+		        std::vector<CDMatrix>& R, std::vector<CDMatrix>& V);
+
+/**
+ * HV = H*V with the double-precision operators at z:
+ * (H*V)_i = W_i*V_i - alpha_i*V_{i-1} - beta_i*V_{i+1}
+ */
+void multiplyMixed(MixedFactorization& factorization, dcomplex z,
+		           std::vector<CDMatrix>& V, std::vector<CDMatrix>& HV);
+
+/**
+ * V of all the blocks refined to double precision; residual is the final
+ * |C - H*V|/|C| and the number of refinement steps is returned
+ */
+int solveMixedRefined(RecursionData& recursionData, dcomplex z,
+		              RefinementData& refinementData,
+		              std::vector<CDMatrix>& V, double& residual);
+
+/**
+ * same as calculateGreenFunc with the mixed-precision recursion;
+ * residualList holds the final relative residual of each z
+ *
+ * IMPORTANT: before calling calculateGreenFuncMixed, you have to call
+ *            setUpIndexInteractions(lattice, interactionData)
+ */
+void calculateGreenFuncMixed(LatticeShape& lattice, Basis& finalSites,
+		                     Basis& initialSites,
+		                     InteractionData& interactionData,
+		                     const std::vector<dcomplex>& zList,
+		                     RefinementData& refinementData,
+		                     std::vector<dcomplex>& gfList,
+		                     std::vector<double>& residualList);
+
+/**
+ * the accuracy check: the largest |G_mixed - G|/|G| over zList, with G from
+ * the double-precision calculateGreenFunc
+ */
+double mixedPrecisionDeviation(LatticeShape& lattice, Basis& finalSites,
+		                       Basis& initialSites,
+		                       InteractionData& interactionData,
+		                       const std::vector<dcomplex>& zList,
+		                       RefinementData& refinementData);
+
+#endif /* MIXEDPRECISION_H_ */
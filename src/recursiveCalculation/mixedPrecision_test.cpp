@@ -0,0 +1,66 @@
+/*
+ * mixedPrecision_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "mixedPrecision.h"
+
+
+TEST(CalculateGreenFuncMixed, SameAsCalculateGreenFunc) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(50);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,3,17,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(24,26);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.5, 0.2));
+	zList.push_back(dcomplex(-1.5, 0.02));
+	RefinementData refinementData = {20, 1e-13};
+
+	Basis finalSitesList[4] = {Basis(24,26), Basis(2,9), Basis(33,35), Basis(0,50)};
+	for (int f=0; f<4; ++f) {
+		std::vector<dcomplex> gfList, gfMixed;
+		std::vector<double> residualList;
+		calculateGreenFunc(lattice1D, finalSitesList[f], initialSites,
+				interactionData, zList, gfList);
+		calculateGreenFuncMixed(lattice1D, finalSitesList[f], initialSites,
+				interactionData, zList, refinementData, gfMixed, residualList);
+		for (int i=0; i<zList.size(); ++i) {
+			EXPECT_LT(residualList[i], 1e-13);
+			EXPECT_NEAR(std::abs(gfMixed[i] - gfList[i]), 0.0, 1e-9*std::abs(gfList[i]));
+		}
+	}
+	EXPECT_LT(mixedPrecisionDeviation(lattice1D, finalSitesList[1], initialSites,
+			interactionData, zList, refinementData), 1e-9);
+	deleteMatrixFiles("A*.bin");
+}
+
+
+TEST(SolveMixedRefined, RefinementIsNeeded) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(40);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,2,5,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(10,11);
+	RecursionData recursionData;
+	setUpRecursion(lattice1D, interactionData, initialSites, recursionData);
+	dcomplex z(0.3, 0.05);
+
+	// the single-precision solution alone
+	RefinementData noRefinement = {0, 0.0};
+	std::vector<CDMatrix> V;
+	double residual;
+	EXPECT_EQ(solveMixedRefined(recursionData, z, noRefinement, V, residual), 0);
+	EXPECT_GT(residual, 1e-10);
+	EXPECT_LT(residual, 1e-3);
+
+	RefinementData refinementData = {20, 1e-13};
+	int iterations = solveMixedRefined(recursionData, z, refinementData, V, residual);
+	EXPECT_LT(residual, 1e-13);
+	EXPECT_GT(iterations, 0);
+	EXPECT_LT(iterations, 6);
+}
@@ -6,6 +6,9 @@
  */
 
 #include "recursiveCalculation.h"
+#include "bandedSolver.h"
+#include "symmetricSolver.h"
+#include "../Utility/blockMemory.h"
 
 
 
@@ -25,7 +28,14 @@ void deleteMatrixFiles(std::string filename_may_contain_wildcard) {
  * The solution will be saved in the X matrix
  */
 void solveDenseLinearEqs(CDMatrix& A, CDMatrix& B, CDMatrix& X) {
-	X = A.colPivHouseholderQr().solve(B);
+	// factorize and solve in two steps so that the profiler can time them apart
+	Eigen::ColPivHouseholderQR<CDMatrix> qr;
+	{
+		PROFILE_SCOPE("factorization");
+		qr.compute(A);
+	}
+	PROFILE_SCOPE("solve");
+	X = qr.solve(B);
 	// try the following slower but more accurate solver
 	//X = A.fullPivHouseholderQr().solve(B);
 }
@@ -72,9 +82,13 @@ int getBasisIndexInVK(LatticeShape& lattice, int K, Basis& basis) {
 	// when i = kbasis, the above loop is over
 	int index1, index2;
 	getLatticeIndex(lattice, basis, index1, index2);
-	extern IMatrix IndexMatrix;
 	// find out G(index1, index2) is the nth elements of v_{Kc} (nth starts from 0)
-	int nth = IndexMatrix(index1, index2);
+	int nth = getIndexInV(index1, index2);
+	if (nth < 0) {
+		std::cout<< "The basis (" << basis[0] <<", "<< basis[1]
+		                        <<") is not in the truncated basis" << std::endl;
+		std::exit(-1);
+	}
 	rowIndex += nth;
 	return rowIndex;
 }
@@ -91,6 +105,12 @@ void setUpIndexInteractions(LatticeShape& lattice,
 	setLatticeAndInteractions(lattice, interactionData);
 }
 
+void setUpIndexInteractions(LatticeShape& lattice,
+		InteractionData& interactionData, int maxRelativeDistance) {
+	generateIndexMatrix(lattice, maxRelativeDistance);
+	setLatticeAndInteractions(lattice, interactionData);
+}
+
 // only for testing purpose
 void setUpIndexInteractions_test(LatticeShape& lattice,
 		InteractionData& interactionData, int radius) {
@@ -204,12 +224,15 @@ void setUpRecursion(LatticeShape& lattice, InteractionData& interactionData,
 
 		int index1, index2;
 		getLatticeIndex(lattice, initialSites, index1, index2);
-		extern IMatrix IndexMatrix;
 		/**
 		 * find out G(index1, index2) is the nth elements of v_{Kc} (nth starts from 0)
 		 * then we know the nth element of the block c_{Kc} is the nonzero element
 		 */
-		int nth = IndexMatrix(index1, index2);
+		int nth = getIndexInV(index1, index2);
+		if (nth < 0) {
+			std::cout << "The initial sites are not in the truncated basis" << std::endl;
+			std::exit(-1);
+		}
 		rowIndex += nth;
 		recursionData.indexForNonzero = rowIndex;
 
@@ -225,13 +248,88 @@ void setUpRecursion(LatticeShape& lattice, InteractionData& interactionData,
 
 
 
+/**
+ * The recursions start at KLeftStart and KRightStart with V_K = 0 outside,
+ * so moving the starts towards KCenter truncates the lattice. The starts
+ * stay aligned with the blocks V_{1+j*maxDistance}.
+ */
+void truncateRecursion(RecursionData& recursionData, int numBlocks) {
+	int maxDistance = recursionData.maxDistance;
+	numBlocks = max(numBlocks, 1);
+	recursionData.KLeftStart = max(recursionData.KLeftStart,
+			recursionData.KLeftStop - (numBlocks-1)*maxDistance);
+	recursionData.KRightStart = min(recursionData.KRightStart,
+			recursionData.KRightStop + (numBlocks-1)*maxDistance);
+}
+
+
+
+/**
+ * the storage of one step of fromRightToCenter (fromLeftToCenter), kept from
+ * one K to the next instead of being allocated and released at every step.
+ * Every buffer holds maxDim x maxDim elements, and the block matrices of a
+ * step are formed in their leading part through a CDMatrixMap.
+ */
+typedef struct {
+	BlockBuffer W;     // W_K, then the factors of W_K - beta_K*A_{K+}
+	BlockBuffer inner; // beta_K (alpha_K on the left)
+	BlockBuffer outer; // alpha_K (beta_K on the left), then A_K
+	BlockBuffer A;     // A_{K+} (ATilde_{K-} on the left)
+	std::vector<int> pivots;
+} RecursionWorkspace;
+
+
+/**
+ * the size of W_K
+ */
+static int blockDimension(int K, int maxDistance) {
+	extern std::vector<int> DimsOfV;
+	int Kmax = DimsOfV.size()-1;
+	int dim = 0;
+	for (int i=K; i<=min(K+maxDistance-1, Kmax); ++i) {
+		dim += DimsOfV[i];
+	}
+	return dim;
+}
+
+
+/**
+ * size the workspace by the largest block met for KLow <= K <= KHigh, and by
+ * the start block (startSize elements) that is copied in before the loop
+ *
+ * The blocks change size at every step, so Eigen matrices would be freed and
+ * allocated again (and, above the mmap threshold of malloc, page-faulted
+ * afresh) at every K. The buffers are allocated once per sweep instead.
+ * When KCenter is next to an edge the loop is empty and KLow > KHigh, so the
+ * start block alone decides the size.
+ */
+static void reserveWorkspace(int KLow, int KHigh, int maxDistance,
+		                     long startSize, RecursionWorkspace& workspace) {
+	extern std::vector<int> DimsOfV;
+	int Kmax = DimsOfV.size()-1;
+	int maxDim = 0;
+	for (int K=max(KLow-maxDistance, 1); K<=min(KHigh+maxDistance, Kmax); ++K) {
+		maxDim = max(maxDim, blockDimension(K, maxDistance));
+	}
+	long size = max((long) maxDim*maxDim, startSize);
+	workspace.W.reserve(size);
+	workspace.inner.reserve(size);
+	workspace.outer.reserve(size);
+	workspace.A.reserve(size);
+	workspace.pivots.reserve(maxDim);
+}
+
+
+
+
 /**
  * recursive calculation from right boundary to the center
  *
  * must call setUpRecursion before calling this function
  */
 void fromRightToCenter( RecursionData& recursionData,
-		dcomplex z, CDMatrix& AKRightStop, bool saveAMatrices) {
+		dcomplex z, CDMatrix& AKRightStop, bool saveAMatrices, double* decay,
+		SpillStore* spill, int KSaveLimit) {
 	int KRightStart=recursionData.KRightStart;
 	int KRightStop=recursionData.KRightStop;
 	int maxDistance=recursionData.maxDistance;
@@ -282,6 +380,7 @@ void fromRightToCenter( RecursionData& recursionData,
 	 *
 	 * This equation can be solved to give A_{KRightStart}
 	 */
+	PROFILE_SCOPE("fromRightToCenter");
 	CDMatrix alphaStart;
 	formMatrixAlpha(KRightStart, alphaStart);
 	/**
@@ -299,8 +398,12 @@ void fromRightToCenter( RecursionData& recursionData,
 	CDMatrix WKPlus; //initially set to W_{KRightStart}
 	formMatrixW(KRightStart,  z, WKPlus);
 
+	// W_{KRightStart} alone is banded in the site ordering; the banded solver
+	// only pays off when truncateRecursion starts the chain inside the lattice,
+	// the blocks at the boundary are too small and go to the dense solver
 	CDMatrix AKPlus;
-	solveDenseLinearEqs(WKPlus, alphaStart, AKPlus);
+	solveBlockLinearEqs(KRightStart, maxDistance, WKPlus, alphaStart, AKPlus);
+	if (decay != NULL) *decay = AKPlus.norm();
 
 	// release memory
 	alphaStart.resize(0,0);
@@ -308,9 +411,15 @@ void fromRightToCenter( RecursionData& recursionData,
 
 	// save the A matrix into a binary file
 	std::string filename;
-	if (saveAMatrices==true) {
-		filename="A"+ itos(KRightStart) + ".bin";
-		saveMatrixBin(filename, AKPlus);
+	if (saveAMatrices==true && KRightStart<=KSaveLimit) {
+		PROFILE_SCOPE("store");
+		PROFILE_BYTES("store", AKPlus.size()*sizeof(dcomplex));
+		if (spill != NULL) {
+			spill->store(KRightStart, AKPlus);
+		} else {
+			filename="A"+ itos(KRightStart) + ".bin";
+			saveMatrixBin(filename, AKPlus);
+		}
 	}
 
 	/**
@@ -335,44 +444,65 @@ void fromRightToCenter( RecursionData& recursionData,
 	 * 	Then A_{K} can be obtained by solving the above linear equations
 	 */
 
+	// W_K, beta_K and alpha_K of every step are formed in the same buffers
+	RecursionWorkspace workspace;
+	int ARows = AKPlus.rows();
+	int ACols = AKPlus.cols();
+	reserveWorkspace(KRightStop, KRightStart-maxDistance, maxDistance,
+			         (long) ARows*ACols, workspace);
+	workspace.A.block(ARows, ACols) = AKPlus;
+	AKPlus.resize(0,0);
 	for (int K=KRightStart-maxDistance; K>=KRightStop; K-=maxDistance) {
-		CDMatrix BetaK;
+		PROFILE_SCOPE_K("rightStep", K);
+		int rows, cols;
+		getBetaSize(K, rows, cols);
+		CDMatrixMap BetaK = workspace.inner.block(rows, cols);
 		formMatrixBeta(K,  BetaK);
 
-		CDMatrix WK;
+		getWSize(K, rows, cols);
+		CDMatrixMap WK = workspace.W.block(rows, cols);
 		formMatrixW(K, z, WK);
 
 		/*
-		 * pLeftSide ===> WK - BetaK*AKPlus;
+		 * WK ===> WK - BetaK*AKPlus;
 		 * using .noalias() as an optimized way to obtain the result without
 		 * evaluating temporary matrices
 		 */
-		CDMatrix * pLeftSide = &WK;
-		(*pLeftSide).noalias() -= BetaK*AKPlus;
-
-		//now Beta is not needed, release its memory
-		BetaK.resize(0,0);
+		{
+			PROFILE_SCOPE("gemm");
+			WK.noalias() -= BetaK*workspace.A.block(ARows, ACols);
+		}
 
-		CDMatrix AlphaK;
+		getAlphaSize(K, rows, cols);
+		CDMatrixMap AlphaK = workspace.outer.block(rows, cols);
 		formMatrixAlpha(K,  AlphaK);
 
-		// solve for AK and assign the value to AKPlus for next iteration
-		solveDenseLinearEqs(*pLeftSide, AlphaK, AKPlus);
-
-		//pLeftSide, WK and AlphaK are not needed, release their memory
-		WK.resize(0,0);
-		pLeftSide = NULL;
-		AlphaK.resize(0,0);
+		// solve for AK in place of AlphaK; its buffer then holds AKPlus for
+		// the next iteration
+		// (W_K - beta_K*A_{K+maxDistance} is complex symmetric)
+		factorizeSymmetricInPlace(WK, workspace.pivots);
+		solveSymmetricInPlace(WK, workspace.pivots, AlphaK);
+		CDMatrixMap& AK = AlphaK;
+		workspace.A.swap(workspace.outer);
+		ARows = AK.rows();
+		ACols = AK.cols();
+		if (decay != NULL) *decay *= AK.norm();
 
 		// save the AK matrix into a binary file
-		if (saveAMatrices==true) {
-			filename="A"+ itos(K) + ".bin";
-			saveMatrixBin(filename, AKPlus);
+		if (saveAMatrices==true && K<=KSaveLimit) {
+			PROFILE_SCOPE("store");
+			PROFILE_BYTES("store", AK.size()*sizeof(dcomplex));
+			if (spill != NULL) {
+				spill->store(K, AK);
+			} else {
+				filename="A"+ itos(K) + ".bin";
+				saveMatrixBin(filename, AK);
+			}
 		}
 	}
 
-	AKRightStop = AKPlus;
-	AKPlus.resize(0,0);
+	allocateMatrix(AKRightStop, ARows, ACols);
+	AKRightStop = workspace.A.block(ARows, ACols);
 }
 
 
@@ -385,7 +515,8 @@ void fromRightToCenter( RecursionData& recursionData,
  * must call setUpRecursion before calling this function
  */
 void fromLeftToCenter( RecursionData& recursionData,
-		dcomplex z, CDMatrix& ATildeKLeftStop, bool saveAMatrices) {
+		dcomplex z, CDMatrix& ATildeKLeftStop, bool saveAMatrices, double* decay,
+		SpillStore* spill, int KSaveLimit) {
 	int KLeftStart=recursionData.KLeftStart;
 	int KLeftStop=recursionData.KLeftStop;
 	int maxDistance=recursionData.maxDistance;
@@ -416,6 +547,7 @@ void fromLeftToCenter( RecursionData& recursionData,
 	 *
 	 * This equation can be solved to give ATilde_{KLeftStart}
 	 */
+	PROFILE_SCOPE("fromLeftToCenter");
 	CDMatrix betaStart;
 	formMatrixBeta(KLeftStart, betaStart);
 	/**
@@ -442,7 +574,8 @@ void fromLeftToCenter( RecursionData& recursionData,
 	formMatrixW(KLeftStart,  z, WKMinus);
 
 	CDMatrix ATildeKMinus; //initially equal to ATilde_{KLeftStart}
-	solveDenseLinearEqs(WKMinus, betaStart, ATildeKMinus);
+	solveBlockLinearEqs(KLeftStart, maxDistance, WKMinus, betaStart, ATildeKMinus);
+	if (decay != NULL) *decay = ATildeKMinus.norm();
 
 	// release memory
 	betaStart.resize(0,0);
@@ -450,9 +583,15 @@ void fromLeftToCenter( RecursionData& recursionData,
 
 	// save the ATilde matrix into a binary file
 	std::string filename;
-	if (saveAMatrices==true) {
-		filename="ATilde"+ itos(KLeftStart) + ".bin";
-		saveMatrixBin(filename, ATildeKMinus);
+	if (saveAMatrices==true && KLeftStart>=KSaveLimit) {
+		PROFILE_SCOPE("store");
+		PROFILE_BYTES("store", ATildeKMinus.size()*sizeof(dcomplex));
+		if (spill != NULL) {
+			spill->store(KLeftStart, ATildeKMinus);
+		} else {
+			filename="ATilde"+ itos(KLeftStart) + ".bin";
+			saveMatrixBin(filename, ATildeKMinus);
+		}
 	}
 
 	/**
@@ -479,41 +618,61 @@ void fromLeftToCenter( RecursionData& recursionData,
 	 * 	once ATilde_{K-} is known
 	 */
 
+	// W_K, alpha_K and beta_K of every step are formed in the same buffers
+	RecursionWorkspace workspace;
+	int ARows = ATildeKMinus.rows();
+	int ACols = ATildeKMinus.cols();
+	reserveWorkspace(KLeftStart+maxDistance, KLeftStop, maxDistance,
+			         (long) ARows*ACols, workspace);
+	workspace.A.block(ARows, ACols) = ATildeKMinus;
+	ATildeKMinus.resize(0,0);
 	for (int K=KLeftStart+maxDistance; K<=KLeftStop; K += maxDistance) {
-		CDMatrix AlphaK;
+		PROFILE_SCOPE_K("leftStep", K);
+		int rows, cols;
+		getAlphaSize(K, rows, cols);
+		CDMatrixMap AlphaK = workspace.inner.block(rows, cols);
 		formMatrixAlpha(K,  AlphaK);
-		CDMatrix WK;
+		getWSize(K, rows, cols);
+		CDMatrixMap WK = workspace.W.block(rows, cols);
 		formMatrixW(K, z, WK);
 		/*
-		 * CDMatrix LeftSide = WK - AlphaK*ATildeKMinus;
-		 * an optimized way to obtain LeftSide without evaluating temporary matrices
+		 * WK ===> WK - AlphaK*ATildeKMinus;
+		 * an optimized way to obtain it without evaluating temporary matrices
 		 */
-		CDMatrix * pLeftSide = &WK;
-		(*pLeftSide).noalias() -= AlphaK*ATildeKMinus;
-
-		//AlphaK is not needed, release its memory
-		AlphaK.resize(0,0);
+		{
+			PROFILE_SCOPE("gemm");
+			WK.noalias() -= AlphaK*workspace.A.block(ARows, ACols);
+		}
 
-		CDMatrix BetaK;
+		getBetaSize(K, rows, cols);
+		CDMatrixMap BetaK = workspace.outer.block(rows, cols);
 		formMatrixBeta(K,  BetaK);
 
-		// solve for ATildeK and assign the value to ATildeKMinus for next iteration
-		solveDenseLinearEqs(*pLeftSide, BetaK, ATildeKMinus);
-
-		//pLeftSide, WK and BetaK are not needed, release their memory
-		WK.resize(0,0);
-		pLeftSide = NULL;
-		BetaK.resize(0,0);
+		// solve for ATildeK in place of BetaK; its buffer then holds
+		// ATildeKMinus for the next iteration
+		factorizeSymmetricInPlace(WK, workspace.pivots);
+		solveSymmetricInPlace(WK, workspace.pivots, BetaK);
+		CDMatrixMap& ATildeK = BetaK;
+		workspace.A.swap(workspace.outer);
+		ARows = ATildeK.rows();
+		ACols = ATildeK.cols();
+		if (decay != NULL) *decay *= ATildeK.norm();
 
 		// save the AK matrix into a binary file
-		if (saveAMatrices==true) {
-			filename="ATilde"+ itos(K) + ".bin";
-			saveMatrixBin(filename, ATildeKMinus);
+		if (saveAMatrices==true && K>=KSaveLimit) {
+			PROFILE_SCOPE("store");
+			PROFILE_BYTES("store", ATildeK.size()*sizeof(dcomplex));
+			if (spill != NULL) {
+				spill->store(K, ATildeK);
+			} else {
+				filename="ATilde"+ itos(K) + ".bin";
+				saveMatrixBin(filename, ATildeK);
+			}
 		}
 	}
 
-	ATildeKLeftStop = ATildeKMinus;
-	ATildeKMinus.resize(0,0);
+	allocateMatrix(ATildeKLeftStop, ARows, ACols);
+	ATildeKLeftStop = workspace.A.block(ARows, ACols);
 }
 
 
@@ -540,6 +699,7 @@ void fromLeftToCenter( RecursionData& recursionData,
 void solveVKCenter(RecursionData& recursionData, dcomplex z,
 		           CDMatrix& ATildeKLeftStop, CDMatrix& AKRightStop,
 		           CDMatrix& VKCenter) {
+	PROFILE_SCOPE("solveVKCenter");
 	int KCenter = recursionData.KCenter;
 	// obtain the lefthand side of the linear equation
 	CDMatrix WKCenter;
@@ -562,8 +722,8 @@ void solveVKCenter(RecursionData& recursionData, dcomplex z,
 	CDMatrix RightSide = CDMatrix::Zero(recursionData.Csize, 1);
 	RightSide(recursionData.indexForNonzero, 0)=dcomplex(1.0, 0.0);
 
-	//solve the linear equation
-	solveDenseLinearEqs(*pLeftSide, RightSide, VKCenter);
+	//solve the linear equation (the left side is complex symmetric)
+	solveSymmetricLinearEqs(*pLeftSide, RightSide, VKCenter);
 }
 
 
@@ -755,26 +915,37 @@ void calculateGreenFunc(LatticeShape& lattice, Basis& finalSites,
 			gf = VKCenter(rowIndex, 0);
 		}
 
-		CDMatrix VKfinal = VKCenter;
-		VKCenter.resize(0,0);
+		// VKCenter is not needed any more, so take its storage
+		CDMatrix VKfinal, VKNext;
+		VKfinal.swap(VKCenter);
 
 		// calculate V_K based on V_K = A*V_{K-1} until V_{Kfinal} is reached
 		if (Kfinal>Kinitial) {
+			CDMatrix A;
 			for (int K=Kinitial+maxDistance; K<=Kfinal; K+=maxDistance) {
-				CDMatrix A;
 				std::string filename = "A"+itos(K)+".bin";
-				loadMatrixBin(filename,A);
-				VKfinal = A*VKfinal;
+				{
+					PROFILE_SCOPE("load");
+					loadMatrixBin(filename,A);
+					PROFILE_BYTES("load", A.size()*sizeof(dcomplex));
+				}
+				VKNext.noalias() = A*VKfinal;
+				VKfinal.swap(VKNext);
 			}
 		}
 
 		// calculate V_K based on V_K = ATilde*V_{K+1} until V_{Kfinal} is reached
 		if (Kfinal<Kinitial) {
+			CDMatrix ATilde;
 			for (int K=Kinitial-maxDistance; K>=Kfinal; K-=maxDistance) {
-				CDMatrix ATilde;
 				std::string filename = "ATilde"+itos(K)+".bin";
-				loadMatrixBin(filename,ATilde);
-				VKfinal = ATilde*VKfinal;
+				{
+					PROFILE_SCOPE("load");
+					loadMatrixBin(filename,ATilde);
+					PROFILE_BYTES("load", ATilde.size()*sizeof(dcomplex));
+				}
+				VKNext.noalias() = ATilde*VKfinal;
+				VKfinal.swap(VKNext);
 			}
 		}
 
@@ -787,6 +958,81 @@ void calculateGreenFunc(LatticeShape& lattice, Basis& finalSites,
 
 }
 
+/**
+ * calculate <final_sites| G(z) |initial_sites> on a window around the
+ * initial sites; the window starts with windowData.initialBlocks blocks on
+ * each side (or enough to reach the final sites) and is doubled until the
+ * decay of both the A and ATilde chains is below the tolerance
+ */
+void calculateGreenFuncWindowed(LatticeShape& lattice, Basis& finalSites,
+		                        Basis& initialSites,
+		                        InteractionData& interactionData,
+		                        const std::vector<dcomplex>& zList,
+		                        WindowData& windowData,
+		                        std::vector<dcomplex>& gfList,
+		                        std::vector<double>& errorList) {
+	RecursionData fullRecursion;
+	setUpRecursion(lattice,  interactionData, initialSites, fullRecursion);
+
+	int maxDistance = interactionData.maxDistance;
+	int Kinitial = fullRecursion.KCenter;
+	int Kfinal = findCorrespondingVK(lattice, maxDistance, finalSites);
+	int rowIndex = getBasisIndexInVK(lattice, Kfinal, finalSites);
+	bool saveATilde = Kfinal<Kinitial;
+	bool saveA = Kfinal>Kinitial;
+
+	// the blocks needed on each side to cover the whole lattice
+	int fullBlocks = max(fullRecursion.KRightStart-fullRecursion.KRightStop,
+			fullRecursion.KLeftStop-fullRecursion.KLeftStart)/maxDistance + 1;
+	// the window must contain V_{Kfinal}
+	int firstBlocks = max(max(windowData.initialBlocks, 1),
+			std::abs(Kfinal-Kinitial)/maxDistance);
+
+	gfList.clear();
+	errorList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		dcomplex z = zList[i];
+
+		RecursionData recursionData;
+		CDMatrix ATildeKLeftStop, AKRightStop;
+		double error;
+		for (int numBlocks=firstBlocks; ; numBlocks*=2) {
+			recursionData = fullRecursion;
+			truncateRecursion(recursionData, numBlocks);
+
+			double leftDecay, rightDecay;
+			fromLeftToCenter(recursionData, z, ATildeKLeftStop, saveATilde, &leftDecay);
+			fromRightToCenter(recursionData, z, AKRightStop, saveA, &rightDecay);
+			// the chains that reach the boundary of the lattice are exact
+			if (recursionData.KLeftStart==fullRecursion.KLeftStart) leftDecay = 0.0;
+			if (recursionData.KRightStart==fullRecursion.KRightStart) rightDecay = 0.0;
+			error = std::max(leftDecay, rightDecay);
+			if (error < windowData.tolerance || numBlocks >= fullBlocks) break;
+		}
+
+		CDMatrix VKfinal;
+		solveVKCenter(recursionData, z, ATildeKLeftStop, AKRightStop, VKfinal);
+		ATildeKLeftStop.resize(0,0);
+		AKRightStop.resize(0,0);
+
+		// the A (ATilde) matrices of the last window are on the disk
+		for (int K=Kinitial+maxDistance; K<=Kfinal; K+=maxDistance) {
+			CDMatrix A;
+			loadMatrixBin("A"+itos(K)+".bin", A);
+			VKfinal = A*VKfinal;
+		}
+		for (int K=Kinitial-maxDistance; K>=Kfinal; K-=maxDistance) {
+			CDMatrix ATilde;
+			loadMatrixBin("ATilde"+itos(K)+".bin", ATilde);
+			VKfinal = ATilde*VKfinal;
+		}
+
+		gfList.push_back(VKfinal(rowIndex, 0));
+		errorList.push_back(error);
+	}
+}
+
+
 /**
  * Extract the Green's function from VK
  *           /                     \
@@ -812,6 +1058,7 @@ void calculateGreenFunc(LatticeShape& lattice, Basis& finalSites,
  */
 void assignValuesToG(LatticeShape& lattice, int K, int maxDistance,
 		             CDMatrix& VK, CDMatrix& gf) {
+	PROFILE_SCOPE("assignValuesToG");
 	extern std::vector< std::vector< Basis > > VtoG;
 	int Kmax = 2*lattice.getXmax() - 1;
 	// number of small v in V_{K}
@@ -849,7 +1096,7 @@ void assignValuesToG(LatticeShape& lattice, int K, int maxDistance,
 void calculateAllGreenFunc(LatticeShape& lattice,  Basis& initialSites,
 		                InteractionData& interactionData,
 		                std::vector<dcomplex> zList,
-                        std::vector< std::string > fileList) {
+                        std::vector< std::string > fileList, double spillTolerance) {
 
 	/**
 	 * figure out the dimensions of the matrix of the Green's functions
@@ -875,20 +1122,33 @@ void calculateAllGreenFunc(LatticeShape& lattice,  Basis& initialSites,
 	RecursionData recursionData;
 	setUpRecursion(lattice,  interactionData, initialSites, recursionData);
 
+	/*
+	 * the A and ATilde matrices are written by a background thread while the
+	 * recursion goes on, and read ahead while V_K is propagated
+	 */
+	SpillStore spillA("A", spillTolerance);
+	SpillStore spillATilde("ATilde", spillTolerance);
+
 	for (int i=0; i<zList.size(); ++i) {
 		dcomplex z = zList[i];
 		std::string filename = fileList[i];
 		/*
-		 * calculate VKCenter and save all A and ATilde matrices into binary files
+		 * calculate VKCenter and save all A and ATilde matrices
 		 * for later usage
 		 * (you need A and ATilde to calculate other VK from VKCenter)
 		 */
 		bool saveATilde = true;
 		bool saveA = true;
 		CDMatrix ATildeKLeftStop;
-		fromLeftToCenter(recursionData, z, ATildeKLeftStop, saveATilde);
+		fromLeftToCenter(recursionData, z, ATildeKLeftStop, saveATilde, NULL, &spillATilde);
 		CDMatrix AKRightStop;
-		fromRightToCenter(recursionData, z, AKRightStop, saveA);
+		fromRightToCenter(recursionData, z, AKRightStop, saveA, NULL, &spillA);
+		if (recursionData.KRightStop<=recursionData.KRightStart) {
+			spillA.prefetch(recursionData.KRightStop);
+		}
+		if (recursionData.KLeftStop>=recursionData.KLeftStart) {
+			spillATilde.prefetch(recursionData.KLeftStop);
+		}
 		CDMatrix VKCenter;
 		solveVKCenter(recursionData, z, ATildeKLeftStop, AKRightStop, VKCenter);
 		// release memory because they are no longer needed
@@ -906,17 +1166,22 @@ void calculateAllGreenFunc(LatticeShape& lattice,  Basis& initialSites,
 		 * from VKCenter and A matrices
 		 */
 		CDMatrix VK = VKCenter;
+		CDMatrix VKNext;
 		int KRightStop = recursionData.KRightStop;
 		int KRightStart = recursionData.KRightStart;
 		for (int K=KRightStop; K<=KRightStart; K+=maxDistance) {
 			CDMatrix A;
-			std::string filename = "A"+itos(K)+".bin";
-			loadMatrixBin(filename,A);
+			{
+				PROFILE_SCOPE("load");
+				spillA.load(K, A);
+				PROFILE_BYTES("load", A.size()*sizeof(dcomplex));
+			}
 
-			// once you load the A matrix, the binary file is no longer need
-			deleteMatrixFiles(filename);
+			// read the next A while this one is used
+			if (K+maxDistance<=KRightStart) spillA.prefetch(K+maxDistance);
 
-			VK = A*VK;
+			VKNext.noalias() = A*VK;
+			VK.swap(VKNext);
 			assignValuesToG(lattice, K, maxDistance, VK, gf);
 			//std::string fileV = "V"+itos(K)+".bin";
 			//saveMatrixBin(fileV, VK);
@@ -926,18 +1191,23 @@ void calculateAllGreenFunc(LatticeShape& lattice,  Basis& initialSites,
 		 * go from the center to the left and calculate all VK with K<KCenter
 		 * from VKCenter and ATilde matrices
 		 */
-		VK = VKCenter;
+		// the left side is the last user of VKCenter
+		VK.swap(VKCenter);
 		int KLeftStop = recursionData.KLeftStop;
 		int KLeftStart = recursionData.KLeftStart;
 		for (int K=KLeftStop; K>=KLeftStart; K-=maxDistance) {
 			CDMatrix ATilde;
-			std::string filename = "ATilde"+itos(K)+".bin";
-			loadMatrixBin(filename,ATilde);
+			{
+				PROFILE_SCOPE("load");
+				spillATilde.load(K, ATilde);
+				PROFILE_BYTES("load", ATilde.size()*sizeof(dcomplex));
+			}
 
-			// once you load the ATilde matrix, the binary file is no longer need
-			deleteMatrixFiles(filename);
+			// read the next ATilde while this one is used
+			if (K-maxDistance>=KLeftStart) spillATilde.prefetch(K-maxDistance);
 
-			VK = ATilde*VK;
+			VKNext.noalias() = ATilde*VK;
+			VK.swap(VKNext);
 			assignValuesToG(lattice, K, maxDistance, VK, gf);
 			// we don't want to save V into disk because it seems useless
 			//std::string fileV = "V"+itos(K)+".bin";
@@ -947,9 +1217,10 @@ void calculateAllGreenFunc(LatticeShape& lattice,  Basis& initialSites,
 
 		// release memory because they are no longer needed
 		VK.resize(0, 0);
-		VKCenter.resize(0, 0);
+		VKNext.resize(0, 0);
 
 		// save the matrix of the Green's functions
+		PROFILE_SCOPE("output");
 		saveMatrix(filename, gf);
 
 	}
@@ -958,6 +1229,110 @@ void calculateAllGreenFunc(LatticeShape& lattice,  Basis& initialSites,
 
 
 
+/**
+ * calculate the line G(m, m+separation; initial_sites) for mMin <= m <= mMax
+ *
+ * The element G(m, m+a) is the row rowOfM[m] of V_{KOfM[m]}, so the wanted
+ * elements are picked up while V_K is propagated from V_{KCenter}, instead of
+ * filling the whole (xmax+1) x (xmax+1) matrix as calculateAllGreenFunc does.
+ * Only the A (ATilde) matrices on the side(s) where the line lies are saved.
+ */
+void calculateGreenFuncLine(LatticeShape& lattice, Basis& initialSites,
+		                    InteractionData& interactionData,
+		                    const std::vector<dcomplex>& zList,
+		                    int separation, int mMin, int mMax,
+		                    std::vector<CDVector>& lineList) {
+	int xmax = lattice.getXmax();
+	if (separation < 1 || mMin < 0 || mMax+separation > xmax || mMin > mMax) {
+		std::cout << "Invalid line: " << mMin << " <= m <= " << mMax
+				  << " with separation " << separation << std::endl;
+		exit(-1);
+	}
+
+	RecursionData recursionData;
+	setUpRecursion(lattice,  interactionData, initialSites, recursionData);
+	int maxDistance = interactionData.maxDistance;
+	int KCenter = recursionData.KCenter;
+
+	// find out where each G(m, m+a) is stored
+	int numM = mMax - mMin + 1;
+	std::vector<int> KOfM(numM);
+	std::vector<int> rowOfM(numM);
+	int KLowest = KCenter;
+	int KHighest = KCenter;
+	for (int i=0; i<numM; ++i) {
+		Basis basis(mMin+i, mMin+i+separation);
+		KOfM[i] = findCorrespondingVK(lattice, maxDistance, basis);
+		rowOfM[i] = getBasisIndexInVK(lattice, KOfM[i], basis);
+		KLowest = min(KLowest, KOfM[i]);
+		KHighest = max(KHighest, KOfM[i]);
+	}
+	bool saveATilde = KLowest < KCenter;
+	bool saveA = KHighest > KCenter;
+
+	lineList.clear();
+	for (int iz=0; iz<zList.size(); ++iz) {
+		dcomplex z = zList[iz];
+		CDVector line = CDVector::Zero(numM);
+
+		CDMatrix ATildeKLeftStop;
+		// the A_K beyond the line are needed for the recursion but not saved
+		fromLeftToCenter(recursionData, z, ATildeKLeftStop, saveATilde, NULL, NULL,
+				KLowest);
+		CDMatrix AKRightStop;
+		fromRightToCenter(recursionData, z, AKRightStop, saveA, NULL, NULL,
+				KHighest);
+		CDMatrix VKCenter;
+		solveVKCenter(recursionData, z, ATildeKLeftStop, AKRightStop, VKCenter);
+		ATildeKLeftStop.resize(0,0);
+		AKRightStop.resize(0,0);
+
+		for (int i=0; i<numM; ++i) {
+			if (KOfM[i]==KCenter) line(i) = VKCenter(rowOfM[i], 0);
+		}
+
+		// go to the right until the last V_K that contains part of the line
+		CDMatrix VK = VKCenter;
+		CDMatrix VKNext;
+		for (int K=recursionData.KRightStop; saveA && K<=KHighest; K+=maxDistance) {
+			std::string filename = "A"+itos(K)+".bin";
+			CDMatrix A;
+			{
+				PROFILE_SCOPE("load");
+				loadMatrixBin(filename,A);
+				PROFILE_BYTES("load", A.size()*sizeof(dcomplex));
+			}
+			remove(filename.c_str());
+			VKNext.noalias() = A*VK;
+			VK.swap(VKNext);
+			for (int i=0; i<numM; ++i) {
+				if (KOfM[i]==K) line(i) = VK(rowOfM[i], 0);
+			}
+		}
+
+		// go to the left until the first V_K that contains part of the line
+		VK.swap(VKCenter);
+		for (int K=recursionData.KLeftStop; saveATilde && K>=KLowest; K-=maxDistance) {
+			std::string filename = "ATilde"+itos(K)+".bin";
+			CDMatrix ATilde;
+			{
+				PROFILE_SCOPE("load");
+				loadMatrixBin(filename,ATilde);
+				PROFILE_BYTES("load", ATilde.size()*sizeof(dcomplex));
+			}
+			remove(filename.c_str());
+			VKNext.noalias() = ATilde*VK;
+			VK.swap(VKNext);
+			for (int i=0; i<numM; ++i) {
+				if (KOfM[i]==K) line(i) = VK(rowOfM[i], 0);
+			}
+		}
+
+		lineList.push_back(line);
+	}
+}
+
+
 /*
  * extract the matrix element G(n, m, initial_sites) from files stored in disk
  *
@@ -8,12 +8,15 @@
 #ifndef RECURSIVECALCULATION_H_
 #define RECURSIVECALCULATION_H_
 
+#include <climits>
 #include "../Utility/types.h"
 #include "../Utility/misc.h"
+#include "../Utility/profiler.h"
 #include "../basis_set/basis.h"
 #include "../IO/binaryIO.h"
 #include "../IO/textIO.h"
 #include "../IO/MatrixIO.h"
+#include "../IO/spillStore.h"
 #include "../formMatrix/formMatrix.h"
 
 typedef struct {
@@ -51,6 +54,15 @@ int getBasisIndexInVK(LatticeShape& lattice, int K, Basis& basis);
 void setUpIndexInteractions(LatticeShape& lattice,
 		InteractionData& interactionData);
 
+/**
+ * the same with the basis truncated to x2 - x1 <= maxRelativeDistance; the
+ * recursion then only handles blocks of size ~maxDistance*maxRelativeDistance/2
+ *
+ * the interaction matrices are not truncated: they take 2*(xmax+1)^2 doubles
+ */
+void setUpIndexInteractions(LatticeShape& lattice,
+		InteractionData& interactionData, int maxRelativeDistance);
+
 void setUpIndexInteractions_test(LatticeShape& lattice,
 		InteractionData& interactionData, int radius);
 
@@ -58,11 +70,32 @@ void setUpRecursion(LatticeShape& lattice, InteractionData& interactionData,
 		            Basis& initialSites, RecursionData& rd);
 
 
+/**
+ * keep at most numBlocks blocks V_K on each side of V_{KCenter}; the
+ * recursion then assumes V_K = 0 beyond the window
+ */
+void truncateRecursion(RecursionData& recursionData, int numBlocks);
+
+/**
+ * if decay is not NULL, it is set to the product of |A_K| (Frobenius norm)
+ * along the chain, an upper bound of |V_{KRightStart}|/|V_{KCenter}|
+ *
+ * the saved A_K go to spill (key K) if it is not NULL, otherwise to A<K>.bin;
+ * only the A_K with K <= KSaveLimit are saved
+ */
 void fromRightToCenter(RecursionData& recursionData,
-		dcomplex z, CDMatrix& AKRightStop, bool saveAMatrices=true);
+		dcomplex z, CDMatrix& AKRightStop, bool saveAMatrices=true,
+		double* decay=NULL, SpillStore* spill=NULL, int KSaveLimit=INT_MAX);
 
+/**
+ * if decay is not NULL, it is set to the product of |ATilde_K| along the chain
+ *
+ * the saved ATilde_K go to spill (key K) if it is not NULL, otherwise to
+ * ATilde<K>.bin; only the ATilde_K with K >= KSaveLimit are saved
+ */
 void fromLeftToCenter(RecursionData& recursionData,
-		dcomplex z, CDMatrix& ATildeKLeftStop, bool saveAMatrices=true);
+		dcomplex z, CDMatrix& ATildeKLeftStop, bool saveAMatrices=true,
+		double* decay=NULL, SpillStore* spill=NULL, int KSaveLimit=INT_MIN);
 
 void solveVKCenter(RecursionData& recursionData, dcomplex z,
 		           CDMatrix& ATildeKLeftStop, CDMatrix& AKRightStop,
@@ -96,13 +129,56 @@ void calculateGreenFunc(LatticeShape& lattice, Basis& finalSites, Basis& initial
 void assignValuesToG(LatticeShape& lattice, int K, int maxDistance, CDMatrix& VK, CDMatrix& gf);
 
 
+typedef struct {
+	int initialBlocks; // the first window has initialBlocks V_K on each side of V_{KCenter}
+	double tolerance; // the window is doubled until the estimated error < tolerance
+} WindowData;
+
+/**
+ * same as calculateGreenFunc, but the recursion only covers a window around
+ * the initial sites, which is grown until the truncation error is below the
+ * tolerance (or the window covers the whole lattice)
+ *
+ * errorList --- the estimated relative error of each z: the larger of the
+ *               decays of the A and ATilde chains over the window, since
+ *               V_K beyond the window is dropped relative to V_{KCenter}
+ *
+ * IMPORTANT: before calling calculateGreenFuncWindowed, you have to call
+ *            setUpIndexInteractions(lattice, interactionData)
+ */
+void calculateGreenFuncWindowed(LatticeShape& lattice, Basis& finalSites,
+		                        Basis& initialSites,
+		                        InteractionData& interactionData,
+		                        const std::vector<dcomplex>& zList,
+		                        WindowData& windowData,
+		                        std::vector<dcomplex>& gfList,
+		                        std::vector<double>& errorList);
+
+
 /**
  * calculate all the matrix elements of the Green function and save them into a text file
  *
+ * the A and ATilde matrices go through a SpillStore with the given tolerance
+ * (< 0 raw, 0 lossless, > 0 lossy, see IO/spillStore.h)
  */
 void calculateAllGreenFunc(LatticeShape& lattice,  Basis& initialSites,
 		                InteractionData& interactionData, std::vector<dcomplex> zList,
-                        std::vector< std::string > fileList);
+                        std::vector< std::string > fileList, double spillTolerance=-1.0);
+
+
+/**
+ * calculate the line G(m, m+separation; initial_sites) for mMin <= m <= mMax
+ * and a list of z values without forming the whole matrix of the Green's
+ * functions: lineList[i](m-mMin) is the value at zList[i]
+ *
+ * IMPORTANT: before calling calculateGreenFuncLine, you have to call
+ *            setUpIndexInteractions(lattice, interactionData)
+ */
+void calculateGreenFuncLine(LatticeShape& lattice, Basis& initialSites,
+		                    InteractionData& interactionData,
+		                    const std::vector<dcomplex>& zList,
+		                    int separation, int mMin, int mMax,
+		                    std::vector<CDVector>& lineList);
 
 
 /*
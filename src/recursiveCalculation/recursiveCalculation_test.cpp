@@ -74,6 +74,41 @@ TEST(FromLeftToCenter, RunningOK) {
 }
 
 
+TEST(FromRightToCenter, SavesUpToLimit) {
+	LatticeShape lattice1D(1);
+	int xmax = 60;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,true,2,230};
+	Basis initialSites(30,31);
+	RecursionData recursionData;
+
+	setUpIndexInteractions(lattice1D, interactionData);
+	setUpRecursion(lattice1D,  interactionData, initialSites, recursionData);
+	int maxDistance = recursionData.maxDistance;
+	dcomplex z = dcomplex(0.5, 0.01);
+
+	deleteMatrixFiles("A[0-9]*.bin");
+	deleteMatrixFiles("ATilde[0-9]*.bin");
+	int KRightLimit = recursionData.KRightStop + maxDistance;
+	CDMatrix AKRightStop;
+	fromRightToCenter(recursionData, z, AKRightStop, true, NULL, NULL, KRightLimit);
+	int KLeftLimit = recursionData.KLeftStop - maxDistance;
+	CDMatrix ATildeKLeftStop;
+	fromLeftToCenter(recursionData, z, ATildeKLeftStop, true, NULL, NULL, KLeftLimit);
+
+	for (int K=recursionData.KRightStop; K<=recursionData.KRightStart; K+=maxDistance) {
+		std::ifstream in(("A"+itos(K)+".bin").c_str());
+		EXPECT_EQ(bool(in), K<=KRightLimit) << "K = " << K;
+	}
+	for (int K=recursionData.KLeftStop; K>=recursionData.KLeftStart; K-=maxDistance) {
+		std::ifstream in(("ATilde"+itos(K)+".bin").c_str());
+		EXPECT_EQ(bool(in), K>=KLeftLimit) << "K = " << K;
+	}
+	deleteMatrixFiles("A[0-9]*.bin");
+	deleteMatrixFiles("ATilde[0-9]*.bin");
+}
+
+
 TEST(SolveVKCenter, RunningOK) {
 	LatticeShape lattice1D(1);
 	int xmax = 121;
@@ -108,6 +143,28 @@ TEST(SolveVKCenter, RunningOK) {
 }
 
 
+TEST(CalculateGreenFunc, InitialSitesAtTheLeftEdge) {
+	LatticeShape lattice1D(1);
+	int xmax = 20;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,true,3,230};
+	setUpIndexInteractions(lattice1D, interactionData);
+
+	// KCenter = 1: the left sweep has no step, and alpha_{KCenter} is out of
+	// range, which must be reported (exit code 255) rather than overrun the
+	// recursion buffers
+	std::vector<dcomplex> zList(1, dcomplex(0.5, 0.05));
+	std::vector<dcomplex> gfList;
+	int sites[3][2] = { {0, 1}, {0, 2}, {1, 2} };
+	for (int i=0; i<3; ++i) {
+		Basis initialSites(sites[i][0], sites[i][1]);
+		EXPECT_EXIT(calculateGreenFunc(lattice1D, initialSites, initialSites,
+				                       interactionData, zList, gfList),
+				    ::testing::ExitedWithCode(255), "");
+	}
+}
+
+
 TEST(GeneratingDensityOfStates, RunningOK) {
 	LatticeShape lattice1D(1);
 	int xmax = 100;
@@ -131,3 +188,137 @@ TEST(GeneratingDensityOfStates, RunningOK) {
 	save_two_arrays("rho_vs_energy.txt", zRealList, rhoList);
 	EXPECT_TRUE(true);
 }
+
+
+TEST(CalculateGreenFuncLine, SameAsAllGreenFunc) {
+	LatticeShape lattice1D(1);
+	int xmax = 40;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,true,3,230,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(20,22);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.5, 0.05));
+	zList.push_back(dcomplex(-1.0, 0.01));
+	std::vector<std::string> fileList;
+	fileList.push_back("lineTest0.bin");
+	fileList.push_back("lineTest1.bin");
+	calculateAllGreenFunc(lattice1D, initialSites, interactionData, zList, fileList);
+
+	// a line on both sides of the initial sites and a line on the right only
+	int a = 2;
+	std::vector<CDVector> lineList;
+	calculateGreenFuncLine(lattice1D, initialSites, interactionData, zList,
+			a, 0, xmax-a, lineList);
+	std::vector<CDVector> rightList;
+	calculateGreenFuncLine(lattice1D, initialSites, interactionData, zList,
+			a, 20, xmax-a, rightList);
+
+	ASSERT_EQ(lineList.size(), 2);
+	for (int i=0; i<zList.size(); ++i) {
+		CDMatrix gf;
+		loadMatrixBin(fileList[i], gf);
+		deleteMatrixFiles(fileList[i]);
+		for (int m=0; m<=xmax-a; ++m) {
+			EXPECT_NEAR(std::abs(lineList[i](m) - gf(m, m+a)), 0.0,
+					1e-12*std::abs(gf(m, m+a)));
+		}
+		for (int m=20; m<=xmax-a; ++m) {
+			EXPECT_NEAR(std::abs(rightList[i](m-20) - gf(m, m+a)), 0.0,
+					1e-12*std::abs(gf(m, m+a)));
+		}
+	}
+}
+
+
+TEST(CalculateGreenFuncWindowed, SameAsCalculateGreenFunc) {
+	LatticeShape lattice1D(1);
+	int xmax = 60;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,2,230,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(30,31);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.5, 0.3));
+	zList.push_back(dcomplex(-1.0, 0.1));
+
+	Basis finalSitesList[3] = {Basis(30,31), Basis(24,27), Basis(35,36)};
+	for (int f=0; f<3; ++f) {
+		std::vector<dcomplex> gfList;
+		calculateGreenFunc(lattice1D, finalSitesList[f], initialSites,
+				interactionData, zList, gfList);
+
+		WindowData windowData = {2, 1e-8};
+		std::vector<dcomplex> windowList;
+		std::vector<double> errorList;
+		calculateGreenFuncWindowed(lattice1D, finalSitesList[f], initialSites,
+				interactionData, zList, windowData, windowList, errorList);
+		for (int i=0; i<zList.size(); ++i) {
+			EXPECT_LT(errorList[i], 1e-8);
+			EXPECT_NEAR(std::abs(windowList[i] - gfList[i]), 0.0,
+					1e-8*std::abs(gfList[i]));
+		}
+
+		// no tolerance can be met: the window grows to the whole lattice
+		windowData.tolerance = 0.0;
+		calculateGreenFuncWindowed(lattice1D, finalSitesList[f], initialSites,
+				interactionData, zList, windowData, windowList, errorList);
+		for (int i=0; i<zList.size(); ++i) {
+			EXPECT_EQ(errorList[i], 0.0);
+			EXPECT_NEAR(std::abs(windowList[i] - gfList[i]), 0.0,
+					1e-12*std::abs(gfList[i]));
+		}
+	}
+	// A*.bin also matches the ATilde files
+	deleteMatrixFiles("A*.bin");
+}
+
+
+TEST(TruncatedBasis, SameAsProjectedHamiltonian) {
+	LatticeShape lattice1D(1);
+	int xmax = 40;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {2.0,1.0,1.0,true,false,true,2,17,true,true};
+	int rMax = 5;
+	setUpIndexInteractions(lattice1D, interactionData, rMax);
+	Basis initialSites(20,22);
+	std::vector<dcomplex> zList(1, dcomplex(0.3, 0.05));
+	int a = 2;
+	std::vector<CDVector> lineList;
+	calculateGreenFuncLine(lattice1D, initialSites, interactionData, zList,
+			a, 0, xmax-a, lineList);
+
+	// (z - H)*G = 1 with H restricted to the pairs x2 - x1 <= rMax
+	std::vector<Basis> pairs;
+	for (int x1=0; x1<=xmax; ++x1) {
+		for (int x2=x1+1; x2<=min(x1+rMax, xmax); ++x2) {
+			pairs.push_back(Basis(x1, x2));
+		}
+	}
+	int size = pairs.size();
+	CDMatrix zMinusH = CDMatrix::Zero(size, size);
+	int source = -1;
+	for (int i=0; i<size; ++i) {
+		zMinusH(i, i) = zList[0] - pInteraction->onsiteE(pairs[i])
+				        - pInteraction->dyn(pairs[i]);
+		// hop() is zero unless the two pairs share a site
+		for (int j=0; j<size; ++j) {
+			if (i!=j) zMinusH(i, j) = -pInteraction->hop(pairs[i], pairs[j]);
+		}
+		if (pairs[i][0]==20 && pairs[i][1]==22) source = i;
+	}
+	CDVector C = CDVector::Zero(size);
+	C(source) = 1.0;
+	CDVector G = zMinusH.partialPivLu().solve(C);
+	for (int i=0; i<size; ++i) {
+		if (pairs[i][1]-pairs[i][0] != a) continue;
+		int m = pairs[i][0];
+		EXPECT_NEAR(std::abs(lineList[0](m) - G(i)), 0.0, 1e-12*std::abs(G(i)));
+	}
+	deleteMatrixFiles("A*.bin");
+
+	// the full basis again for the other tests
+	generateIndexMatrix(lattice1D);
+}
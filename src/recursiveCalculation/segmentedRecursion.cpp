@@ -0,0 +1,243 @@
+/*
+ * segmentedRecursion.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "segmentedRecursion.h"
+#include "bandedSolver.h"
+#include "symmetricSolver.h"
+
+
+BlockChain rightChain(RecursionData& recursionData) {
+	BlockChain chain;
+	int maxDistance = recursionData.maxDistance;
+	chain.K0 = recursionData.KRightStop;
+	chain.step = maxDistance;
+	chain.numBlocks = max((recursionData.KRightStart-recursionData.KRightStop)/maxDistance + 1, 1);
+	chain.left = false;
+	return chain;
+}
+
+
+BlockChain leftChain(RecursionData& recursionData) {
+	BlockChain chain;
+	int maxDistance = recursionData.maxDistance;
+	chain.K0 = max(recursionData.KLeftStop, recursionData.KLeftStart);
+	chain.step = -maxDistance;
+	chain.numBlocks = (chain.K0-recursionData.KLeftStart)/maxDistance + 1;
+	chain.left = true;
+	return chain;
+}
+
+
+void formChainBlocks(const BlockChain& chain, int j, dcomplex z,
+		             CDMatrix& W, CDMatrix& inner, CDMatrix& outer) {
+	int K = chain.K0 + j*chain.step;
+	bool outermost = (j == chain.numBlocks-1);
+	formMatrixW(K, z, W);
+	if (chain.left) {
+		formMatrixBeta(K, inner);
+		if (!outermost) formMatrixAlpha(K, outer);
+	} else {
+		formMatrixAlpha(K, inner);
+		if (!outermost) formMatrixBeta(K, outer);
+	}
+}
+
+
+typedef struct {
+	int first; // a
+	int last;  // b
+	CDMatrix AFirst, EFirst;     // A_a, E_a
+	CDMatrix ATildeLast, FLast;  // ATilde_b, F_b
+	CDMatrix M;                  // V_b = M*V_{a-1}
+	CDMatrix AExact;             // V_a = AExact*V_{a-1}
+	std::vector<CDMatrix> A, E;  // A_j, E_j of all the blocks, if kept
+} ChainSegment;
+
+
+/**
+ * the two sweeps of one segment; the outermost segment has V_{b+1} = 0 and
+ * only needs the plain recursion
+ */
+static void eliminateSegment(const BlockChain& chain, dcomplex z, bool keepBlocks,
+		                     ChainSegment& segment) {
+	int a = segment.first;
+	int b = segment.last;
+	bool outermost = (b == chain.numBlocks-1);
+	if (keepBlocks) {
+		segment.A.resize(b-a+1);
+		segment.E.resize(b-a+1);
+	}
+
+	// from b to a: (W_j - outer_j*A_{j+1})*[A_j, E_j] = [inner_j, outer_j*E_{j+1}]
+	CDMatrix APlus, EPlus;
+	for (int j=b; j>=a; --j) {
+		CDMatrix W, inner, outer;
+		formChainBlocks(chain, j, z, W, inner, outer);
+		CDMatrix rightSide;
+		if (outermost) {
+			rightSide = inner;
+		} else {
+			CDMatrix outerE = (j==b) ? outer : CDMatrix(outer*EPlus);
+			rightSide.resize(W.rows(), inner.cols()+outerE.cols());
+			rightSide << inner, outerE;
+		}
+		CDMatrix X;
+		if (j<b) {
+			W.noalias() -= outer*APlus;
+			solveSymmetricLinearEqs(W, rightSide, X);
+		} else {
+			solveBlockLinearEqs(chain.K0+j*chain.step, std::abs(chain.step), W, rightSide, X);
+		}
+		APlus = X.leftCols(inner.cols());
+		if (!outermost) EPlus = X.rightCols(X.cols()-inner.cols());
+		if (keepBlocks) {
+			segment.A[j-a] = APlus;
+			segment.E[j-a] = EPlus;
+		}
+	}
+	segment.AFirst = APlus;
+	segment.EFirst = EPlus;
+	if (outermost) return;
+
+	// from a to b: (W_j - inner_j*ATilde_{j-1})*[ATilde_j, F_j] = [outer_j, inner_j*F_{j-1}]
+	CDMatrix ATildeMinus, FMinus;
+	for (int j=a; j<=b; ++j) {
+		CDMatrix W, inner, outer;
+		formChainBlocks(chain, j, z, W, inner, outer);
+		CDMatrix innerF = (j==a) ? inner : CDMatrix(inner*FMinus);
+		CDMatrix rightSide(W.rows(), outer.cols()+innerF.cols());
+		rightSide << outer, innerF;
+		CDMatrix X;
+		if (j>a) {
+			W.noalias() -= inner*ATildeMinus;
+			solveSymmetricLinearEqs(W, rightSide, X);
+		} else {
+			solveBlockLinearEqs(chain.K0+j*chain.step, std::abs(chain.step), W, rightSide, X);
+		}
+		ATildeMinus = X.leftCols(outer.cols());
+		FMinus = X.rightCols(X.cols()-outer.cols());
+	}
+	segment.ATildeLast = ATildeMinus;
+	segment.FLast = FMinus;
+}
+
+
+/**
+ * eliminate the segments in parallel and join them from the outermost one;
+ * the blocks A_j, E_j of the segment containing keepBlock are kept
+ */
+static void reduceChain(const BlockChain& chain, dcomplex z, int numSegments,
+		                int keepBlock, std::vector<ChainSegment>& segments) {
+	int n = chain.numBlocks;
+	numSegments = max(1, min(numSegments, n));
+	segments.clear();
+	segments.resize(numSegments);
+	for (int s=0; s<numSegments; ++s) {
+		segments[s].first = s*n/numSegments;
+		segments[s].last = (s+1)*n/numSegments - 1;
+	}
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int s=0; s<numSegments; ++s) {
+		bool keepBlocks = keepBlock>=segments[s].first && keepBlock<=segments[s].last;
+		eliminateSegment(chain, z, keepBlocks, segments[s]);
+	}
+
+	segments[numSegments-1].AExact = segments[numSegments-1].AFirst;
+	for (int s=numSegments-2; s>=0; --s) {
+		ChainSegment& segment = segments[s];
+		CDMatrix& ANext = segments[s+1].AExact;
+		// V_b = (1 - ATilde_b*A_{b+1})^{-1}*F_b*V_{a-1}
+		CDMatrix leftSide = -segment.ATildeLast*ANext;
+		leftSide.diagonal().array() += 1.0;
+		solveDenseLinearEqs(leftSide, segment.FLast, segment.M);
+		segment.AExact = segment.AFirst + segment.EFirst*(ANext*segment.M);
+	}
+}
+
+
+/**
+ * V_{jFinal} from V_{-1} = V_{KCenter}
+ */
+static void propagateToBlock(const std::vector<ChainSegment>& segments, int jFinal,
+		                     CDMatrix V, CDMatrix& VFinal) {
+	for (int s=0; s<segments.size(); ++s) {
+		const ChainSegment& segment = segments[s];
+		if (jFinal > segment.last) {
+			V = segment.M*V; // V_{a-1} of the next segment
+			continue;
+		}
+		bool outermost = (s == segments.size()-1);
+		CDMatrix VOuter;
+		if (!outermost) VOuter = segments[s+1].AExact*(segment.M*V);
+		for (int j=segment.first; j<=jFinal; ++j) {
+			V = segment.A[j-segment.first]*V;
+			if (!outermost) V += segment.E[j-segment.first]*VOuter;
+		}
+		break;
+	}
+	VFinal = V;
+}
+
+
+void fromRightToCenterSegmented(RecursionData& recursionData, dcomplex z,
+		                        int numSegments, CDMatrix& AKRightStop) {
+	PROFILE_SCOPE("fromRightToCenterSegmented");
+	std::vector<ChainSegment> segments;
+	reduceChain(rightChain(recursionData), z, numSegments, -1, segments);
+	AKRightStop = segments[0].AExact;
+}
+
+
+void fromLeftToCenterSegmented(RecursionData& recursionData, dcomplex z,
+		                       int numSegments, CDMatrix& ATildeKLeftStop) {
+	PROFILE_SCOPE("fromLeftToCenterSegmented");
+	std::vector<ChainSegment> segments;
+	reduceChain(leftChain(recursionData), z, numSegments, -1, segments);
+	ATildeKLeftStop = segments[0].AExact;
+}
+
+
+void calculateGreenFuncSegmented(LatticeShape& lattice, Basis& finalSites,
+		                         Basis& initialSites,
+		                         InteractionData& interactionData,
+		                         const std::vector<dcomplex>& zList,
+		                         int numSegments,
+		                         std::vector<dcomplex>& gfList) {
+	RecursionData recursionData;
+	setUpRecursion(lattice, interactionData, initialSites, recursionData);
+
+	int maxDistance = interactionData.maxDistance;
+	int Kinitial = recursionData.KCenter;
+	int Kfinal = findCorrespondingVK(lattice, maxDistance, finalSites);
+	int rowIndex = getBasisIndexInVK(lattice, Kfinal, finalSites);
+
+	BlockChain left = leftChain(recursionData);
+	BlockChain right = rightChain(recursionData);
+	int keepLeft = (Kfinal<Kinitial) ? (Kfinal-left.K0)/left.step : -1;
+	int keepRight = (Kfinal>Kinitial) ? (Kfinal-right.K0)/right.step : -1;
+
+	gfList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		dcomplex z = zList[i];
+		std::vector<ChainSegment> leftSegments, rightSegments;
+		reduceChain(left, z, numSegments, keepLeft, leftSegments);
+		reduceChain(right, z, numSegments, keepRight, rightSegments);
+
+		CDMatrix VKCenter;
+		solveVKCenter(recursionData, z, leftSegments[0].AExact,
+				rightSegments[0].AExact, VKCenter);
+
+		CDMatrix VKfinal = VKCenter;
+		if (Kfinal>Kinitial) {
+			propagateToBlock(rightSegments, keepRight, VKCenter, VKfinal);
+		} else if (Kfinal<Kinitial) {
+			propagateToBlock(leftSegments, keepLeft, VKCenter, VKfinal);
+		}
+		gfList.push_back(VKfinal(rowIndex, 0));
+	}
+}
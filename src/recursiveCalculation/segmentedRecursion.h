@@ -0,0 +1,94 @@
+/*
+ * segmentedRecursion.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * The recursions of fromRightToCenter and fromLeftToCenter with the chain of
+ * blocks cut into segments that are eliminated at the same time.
+ *
+ * Number the blocks of one side j = 0, 1, ..., n-1 going away from V_{KCenter}
+ * (V_{-1} = V_{KCenter}, V_{n} = 0):
+ *
+ *   W_j*V_j = inner_j*V_{j-1} + outer_j*V_{j+1}
+ *
+ * (inner = alpha, outer = beta on the right side and the opposite on the
+ * left). Inside a segment a <= j <= b the two neighbors V_{a-1} and V_{b+1}
+ * are kept as unknowns:
+ *
+ *   V_j = A_j*V_{j-1} + E_j*V_{b+1}          (sweep from b to a)
+ *   V_j = ATilde_j*V_{j+1} + F_j*V_{a-1}     (sweep from a to b)
+ *
+ * Every segment does its sweeps independently. With the exact A_{b+1} of
+ * the next segment, V_{b+1} = A_{b+1}*V_b, the ends of the segment give
+ *
+ *   V_b = (1 - ATilde_b*A_{b+1})^{-1}*F_b*V_{a-1} = M*V_{a-1}
+ *   A_a (exact) = A_a + E_a*A_{b+1}*M
+ *
+ * which is a short serial pass from the outermost segment to the center.
+ * A segment costs about three times the plain recursion, so this pays off
+ * for a single energy on a long lattice with several cores; with
+ * numSegments = 1 it is the plain recursion.
+ */
+
+#ifndef SEGMENTEDRECURSION_H_
+#define SEGMENTEDRECURSION_H_
+
+#include "recursiveCalculation.h"
+
+
+/**
+ * one side of the recursion: block j is V_{K0 + j*step}
+ */
+typedef struct {
+	int K0;
+	int step;
+	int numBlocks;
+	bool left;
+} BlockChain;
+
+/**
+ * the blocks of fromRightToCenter, from KRightStop to KRightStart
+ */
+BlockChain rightChain(RecursionData& recursionData);
+
+/**
+ * the blocks of fromLeftToCenter, from KLeftStop to KLeftStart (like
+ * fromLeftToCenter, a single block KLeftStart if KLeftStop < KLeftStart)
+ */
+BlockChain leftChain(RecursionData& recursionData);
+
+/**
+ * W_j, inner_j (coupling to V_{j-1}) and outer_j (coupling to V_{j+1}); the
+ * outermost block has no outer coupling
+ */
+void formChainBlocks(const BlockChain& chain, int j, dcomplex z,
+		             CDMatrix& W, CDMatrix& inner, CDMatrix& outer);
+
+/**
+ * the same A_{KRightStop} as fromRightToCenter (no A matrices are saved)
+ */
+void fromRightToCenterSegmented(RecursionData& recursionData, dcomplex z,
+		                        int numSegments, CDMatrix& AKRightStop);
+
+/**
+ * the same ATilde_{KLeftStop} as fromLeftToCenter (no ATilde matrices are saved)
+ */
+void fromLeftToCenterSegmented(RecursionData& recursionData, dcomplex z,
+		                       int numSegments, CDMatrix& ATildeKLeftStop);
+
+/**
+ * same as calculateGreenFunc, with both sides of the recursion cut into
+ * numSegments segments; nothing is written to the disk
+ *
+ * IMPORTANT: before calling calculateGreenFuncSegmented, you have to call
+ *            setUpIndexInteractions(lattice, interactionData)
+ */
+void calculateGreenFuncSegmented(LatticeShape& lattice, Basis& finalSites,
+		                         Basis& initialSites,
+		                         InteractionData& interactionData,
+		                         const std::vector<dcomplex>& zList,
+		                         int numSegments,
+		                         std::vector<dcomplex>& gfList);
+
+#endif /* SEGMENTEDRECURSION_H_ */
@@ -0,0 +1,63 @@
+/*
+ * segmentedRecursion_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "segmentedRecursion.h"
+
+
+TEST(FromRightToCenterSegmented, SameAsFromRightToCenter) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(50);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,3,41,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(12,14);
+	RecursionData recursionData;
+	setUpRecursion(lattice1D, interactionData, initialSites, recursionData);
+	dcomplex z(0.4, 0.2);
+
+	CDMatrix AKRightStop, ATildeKLeftStop;
+	fromRightToCenter(recursionData, z, AKRightStop, false);
+	fromLeftToCenter(recursionData, z, ATildeKLeftStop, false);
+	int segmentsList[3] = {1, 4, 100};
+	for (int i=0; i<3; ++i) {
+		CDMatrix ASegmented, ATildeSegmented;
+		fromRightToCenterSegmented(recursionData, z, segmentsList[i], ASegmented);
+		fromLeftToCenterSegmented(recursionData, z, segmentsList[i], ATildeSegmented);
+		EXPECT_LT((ASegmented-AKRightStop).norm(), 1e-10*AKRightStop.norm());
+		EXPECT_LT((ATildeSegmented-ATildeKLeftStop).norm(), 1e-10*ATildeKLeftStop.norm());
+	}
+}
+
+
+TEST(CalculateGreenFuncSegmented, SameAsCalculateGreenFunc) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(40);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,2,230,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(20,21);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.5, 0.3));
+	zList.push_back(dcomplex(-1.0, 0.05));
+
+	Basis finalSitesList[4] = {Basis(20,21), Basis(3,10), Basis(27,28), Basis(38,40)};
+	for (int f=0; f<4; ++f) {
+		std::vector<dcomplex> gfList;
+		calculateGreenFunc(lattice1D, finalSitesList[f], initialSites,
+				interactionData, zList, gfList);
+		for (int numSegments=1; numSegments<=9; numSegments+=4) {
+			std::vector<dcomplex> segmentedList;
+			calculateGreenFuncSegmented(lattice1D, finalSitesList[f], initialSites,
+					interactionData, zList, numSegments, segmentedList);
+			for (int i=0; i<zList.size(); ++i) {
+				EXPECT_NEAR(std::abs(segmentedList[i] - gfList[i]), 0.0,
+						1e-10*std::abs(gfList[i]));
+			}
+		}
+	}
+	deleteMatrixFiles("A*.bin");
+}
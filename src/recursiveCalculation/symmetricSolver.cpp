@@ -0,0 +1,210 @@
+/*
+ * symmetricSolver.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "symmetricSolver.h"
+
+
+/**
+ * |Re(x)| + |Im(x)|, the pivot size of LAPACK
+ */
+static double cabs1(dcomplex x) {
+	return std::abs(x.real()) + std::abs(x.imag());
+}
+
+
+/**
+ * the largest cabs1 of a(first:n-1, col); its row goes to index
+ */
+static double columnMax(const Eigen::Ref<const CDMatrix>& a, int col, int first, int& index) {
+	double largest = -1.0;
+	index = first;
+	for (int i=first; i<a.rows(); ++i) {
+		if (cabs1(a(i, col)) > largest) {
+			largest = cabs1(a(i, col));
+			index = i;
+		}
+	}
+	return largest;
+}
+
+
+/**
+ * the largest cabs1 of a(row, first:last-1)
+ */
+static double rowMax(const Eigen::Ref<const CDMatrix>& a, int row, int first, int last) {
+	double largest = 0.0;
+	for (int j=first; j<last; ++j) {
+		largest = std::max(largest, cabs1(a(row, j)));
+	}
+	return largest;
+}
+
+
+/**
+ * factorize a in place
+ */
+static void factorizeLD(Eigen::Ref<CDMatrix> a, std::vector<int>& pivots) {
+	PROFILE_SCOPE("factorizeSymmetric");
+	const double alpha = (1.0 + std::sqrt(17.0))/8.0;
+	int n = a.rows();
+	pivots.resize(n);
+
+	int k = 0;
+	while (k < n) {
+		int kstep = 1;
+		int kp = k;
+		double absakk = cabs1(a(k, k));
+		int imax = k;
+		double colmax = 0.0;
+		if (k < n-1) {
+			colmax = columnMax(a, k, k+1, imax);
+		}
+		if (std::max(absakk, colmax) == 0.0) {
+			std::cout << "The complex symmetric matrix is singular" << std::endl;
+			exit(-1);
+		}
+
+		if (absakk < alpha*colmax) {
+			// the largest element in row imax (in the lower triangle)
+			int jmax;
+			double rowmax = rowMax(a, imax, k, imax);
+			if (imax < n-1) rowmax = std::max(rowmax, columnMax(a, imax, imax+1, jmax));
+			if (absakk >= alpha*colmax*(colmax/rowmax)) {
+				kp = k;
+			} else if (cabs1(a(imax, imax)) >= alpha*rowmax) {
+				kp = imax;
+			} else {
+				kp = imax;
+				kstep = 2;
+			}
+		}
+
+		// swap the rows and columns kk and kp of the trailing matrix
+		int kk = k + kstep - 1;
+		if (kp != kk) {
+			if (kp < n-1) a.col(kk).tail(n-kp-1).swap(a.col(kp).tail(n-kp-1));
+			for (int j=kk+1; j<kp; ++j) {
+				std::swap(a(j, kk), a(kp, j));
+			}
+			std::swap(a(kk, kk), a(kp, kp));
+			if (kstep == 2) std::swap(a(k+1, k), a(kp, k));
+		}
+
+		if (kstep == 1) {
+			// A_{k+1:n, k+1:n} -= a_k*a_k^T/d, only the lower triangle
+			dcomplex d11 = 1.0/a(k, k);
+			for (int j=k+1; j<n; ++j) {
+				a.col(j).tail(n-j) -= a.col(k).tail(n-j)*(d11*a(j, k));
+			}
+			a.col(k).tail(n-k-1) *= d11;
+			pivots[k] = kp;
+		} else {
+			if (k < n-2) {
+				dcomplex d21 = a(k+1, k);
+				dcomplex d11 = a(k+1, k+1)/d21;
+				dcomplex d22 = a(k, k)/d21;
+				dcomplex t = 1.0/(d11*d22 - 1.0);
+				d21 = t/d21;
+				for (int j=k+2; j<n; ++j) {
+					dcomplex wk = d21*(d11*a(j, k) - a(j, k+1));
+					dcomplex wkp1 = d21*(d22*a(j, k+1) - a(j, k));
+					a.col(j).tail(n-j) -= a.col(k).tail(n-j)*wk + a.col(k+1).tail(n-j)*wkp1;
+					a(j, k) = wk;
+					a(j, k+1) = wkp1;
+				}
+			}
+			pivots[k] = -(kp+1);
+			pivots[k+1] = -(kp+1);
+		}
+		k += kstep;
+	}
+}
+
+
+/**
+ * X = A^{-1}*X with the factors a and pivots of A
+ */
+static void solveLD(const Eigen::Ref<const CDMatrix>& a, const std::vector<int>& pivots,
+		            Eigen::Ref<CDMatrix> X) {
+	PROFILE_SCOPE("solveSymmetric");
+	int n = a.rows();
+
+	// L*D*Y = P*B
+	int k = 0;
+	while (k < n) {
+		if (pivots[k] >= 0) {
+			if (pivots[k] != k) X.row(k).swap(X.row(pivots[k]));
+			if (k < n-1) X.bottomRows(n-k-1).noalias() -= a.col(k).tail(n-k-1)*X.row(k);
+			X.row(k) /= a(k, k);
+			k += 1;
+		} else {
+			int kp = -pivots[k]-1;
+			if (kp != k+1) X.row(k+1).swap(X.row(kp));
+			if (k < n-2) {
+				X.bottomRows(n-k-2).noalias() -= a.col(k).tail(n-k-2)*X.row(k);
+				X.bottomRows(n-k-2).noalias() -= a.col(k+1).tail(n-k-2)*X.row(k+1);
+			}
+			dcomplex akm1k = a(k+1, k);
+			dcomplex akm1 = a(k, k)/akm1k;
+			dcomplex ak = a(k+1, k+1)/akm1k;
+			dcomplex denom = akm1*ak - 1.0;
+			CDMatrix bkm1 = X.row(k)/akm1k;
+			CDMatrix bk = X.row(k+1)/akm1k;
+			X.row(k) = (ak*bkm1 - bk)/denom;
+			X.row(k+1) = (akm1*bk - bkm1)/denom;
+			k += 2;
+		}
+	}
+
+	// L^T*P*X = Y
+	k = n-1;
+	while (k >= 0) {
+		if (pivots[k] >= 0) {
+			if (k < n-1) X.row(k).noalias() -= a.col(k).tail(n-k-1).transpose()*X.bottomRows(n-k-1);
+			if (pivots[k] != k) X.row(k).swap(X.row(pivots[k]));
+			k -= 1;
+		} else {
+			if (k < n-1) {
+				X.row(k).noalias() -= a.col(k).tail(n-k-1).transpose()*X.bottomRows(n-k-1);
+				X.row(k-1).noalias() -= a.col(k-1).tail(n-k-1).transpose()*X.bottomRows(n-k-1);
+			}
+			int kp = -pivots[k]-1;
+			if (kp != k) X.row(k).swap(X.row(kp));
+			k -= 2;
+		}
+	}
+}
+
+
+void factorizeSymmetric(const CDMatrix& A, SymmetricLDLT& factors) {
+	factors.ld = A;
+	factorizeLD(factors.ld, factors.pivots);
+}
+
+
+void factorizeSymmetricInPlace(CDMatrixMap& A, std::vector<int>& pivots) {
+	factorizeLD(A, pivots);
+}
+
+
+void solveSymmetric(const SymmetricLDLT& factors, const CDMatrix& B, CDMatrix& X) {
+	X = B;
+	solveLD(factors.ld, factors.pivots, X);
+}
+
+
+void solveSymmetricInPlace(const CDMatrixMap& ld, const std::vector<int>& pivots,
+		                   CDMatrixMap& X) {
+	solveLD(ld, pivots, X);
+}
+
+
+void solveSymmetricLinearEqs(CDMatrix& A, CDMatrix& B, CDMatrix& X) {
+	SymmetricLDLT factors;
+	factorizeSymmetric(A, factors);
+	solveSymmetric(factors, B, X);
+}
@@ -0,0 +1,61 @@
+/*
+ * symmetricSolver.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * LDL^T factorization of complex symmetric matrices (A = A^T, not Hermitian)
+ * with Bunch-Kaufman pivoting, as in LAPACK's zsytf2/zsytrs:
+ *
+ *   P*A*P^T = L*D*L^T
+ *
+ * L is unit lower triangular and D has 1x1 and 2x2 blocks.
+ *
+ * H is real symmetric and beta_K = alpha_{K+maxDistance}^T, so W_K = z - H_K
+ * and every matrix of the recursion
+ *
+ *   W_K - beta_K*A_{K+} = W_K - alpha_{K+}^T*(W_{K+} - ...)^{-1}*alpha_{K+}
+ *
+ * (and the same with ATilde, and the center matrix of solveVKCenter) are
+ * complex symmetric. The factorization only reads the lower triangle and
+ * needs n^3/3 flops against 4n^3/3 for the QR of solveDenseLinearEqs.
+ */
+
+#ifndef SYMMETRICSOLVER_H_
+#define SYMMETRICSOLVER_H_
+
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../Utility/profiler.h"
+
+
+typedef struct {
+	CDMatrix ld;             // L below the diagonal, D on the diagonal and the first subdiagonal
+	/**
+	 * pivots[k] >= 0: 1x1 block, row k was swapped with row pivots[k];
+	 * pivots[k] = pivots[k+1] = -(p+1): 2x2 block, row k+1 was swapped with row p
+	 */
+	std::vector<int> pivots;
+} SymmetricLDLT;
+
+
+void factorizeSymmetric(const CDMatrix& A, SymmetricLDLT& factors);
+
+void solveSymmetric(const SymmetricLDLT& factors, const CDMatrix& B, CDMatrix& X);
+
+/**
+ * the same in the caller's storage, so that a loop factorizing one matrix per
+ * step keeps reusing the same buffers: A is overwritten with the ld of its
+ * factors, and X holds B on entry and the solution on return
+ */
+void factorizeSymmetricInPlace(CDMatrixMap& A, std::vector<int>& pivots);
+
+void solveSymmetricInPlace(const CDMatrixMap& ld, const std::vector<int>& pivots,
+		                   CDMatrixMap& X);
+
+/**
+ * A*X = B for a complex symmetric A (only the lower triangle is used)
+ */
+void solveSymmetricLinearEqs(CDMatrix& A, CDMatrix& B, CDMatrix& X);
+
+#endif /* SYMMETRICSOLVER_H_ */
@@ -0,0 +1,77 @@
+/*
+ * symmetricSolver_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "symmetricSolver.h"
+#include "recursiveCalculation.h"
+
+
+TEST(SymmetricSolver, SameAsDenseSolver) {
+	int n = 50;
+	srand(7);
+	CDMatrix A = CDMatrix::Random(n, n);
+	A = (A + A.transpose()).eval();
+	CDMatrix B = CDMatrix::Random(n, 4);
+	CDMatrix X, XDense;
+	solveSymmetricLinearEqs(A, B, X);
+	solveDenseLinearEqs(A, B, XDense);
+	EXPECT_LT((X-XDense).norm(), 1e-10*XDense.norm());
+
+	// a zero diagonal needs the 2x2 pivots; the upper triangle is not read
+	A.diagonal().setZero();
+	CDMatrix ALower = A.triangularView<Eigen::Lower>();
+	SymmetricLDLT factors;
+	factorizeSymmetric(ALower, factors);
+	bool twoByTwo = false;
+	for (int k=0; k<n; ++k) {
+		if (factors.pivots[k] < 0) twoByTwo = true;
+	}
+	EXPECT_TRUE(twoByTwo);
+	solveSymmetric(factors, B, X);
+	EXPECT_LT((A*X-B).norm(), 1e-10*B.norm());
+
+	// the same in a buffer larger than the matrices
+	CDVector storage(2*n*n);
+	CDMatrixMap AInPlace(storage.data(), n, n);
+	AInPlace = ALower;
+	std::vector<int> pivots;
+	factorizeSymmetricInPlace(AInPlace, pivots);
+	EXPECT_TRUE(AInPlace == factors.ld);
+	EXPECT_TRUE(pivots == factors.pivots);
+	CDMatrixMap XInPlace(storage.data()+n*n, n, B.cols());
+	XInPlace = B;
+	solveSymmetricInPlace(AInPlace, pivots, XInPlace);
+	EXPECT_TRUE(XInPlace == X);
+}
+
+
+TEST(SymmetricSolver, RecursionMatrix) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(40);
+	int maxDistance = 3;
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,maxDistance,23,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	dcomplex z(0.3, 0.1);
+
+	// M_K = W_K - beta_K*A_{K+maxDistance} is complex symmetric
+	int K = 1 + maxDistance*10;
+	CDMatrix W, WPlus, alphaPlus, beta, APlus;
+	formMatrixW(K, z, W);
+	formMatrixW(K+maxDistance, z, WPlus);
+	formMatrixAlpha(K+maxDistance, alphaPlus);
+	formMatrixBeta(K, beta);
+	solveDenseLinearEqs(WPlus, alphaPlus, APlus);
+	CDMatrix M = W - beta*APlus;
+	EXPECT_LT((M-M.transpose()).norm(), 1e-12*M.norm());
+
+	CDMatrix alpha;
+	formMatrixAlpha(K, alpha);
+	CDMatrix X, XDense;
+	solveSymmetricLinearEqs(M, alpha, X);
+	solveDenseLinearEqs(M, alpha, XDense);
+	EXPECT_LT((X-XDense).norm(), 1e-12*XDense.norm());
+}
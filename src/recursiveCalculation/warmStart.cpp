@@ -0,0 +1,153 @@
+/*
+ * warmStart.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "warmStart.h"
+
+
+/**
+ * <x, y> = sum_i x_i^H * y_i over the blocks
+ */
+static dcomplex innerProduct(std::vector<CDMatrix>& x, std::vector<CDMatrix>& y) {
+	dcomplex result(0.0, 0.0);
+	for (int i=0; i<x.size(); ++i) {
+		result += (x[i].adjoint()*y[i])(0, 0);
+	}
+	return result;
+}
+
+
+static double blockNorm(std::vector<CDMatrix>& x) {
+	double norm2 = 0.0;
+	for (int i=0; i<x.size(); ++i) {
+		norm2 += x[i].squaredNorm();
+	}
+	return std::sqrt(norm2);
+}
+
+
+/**
+ * y = a*x + y
+ */
+static void addScaled(dcomplex a, std::vector<CDMatrix>& x, std::vector<CDMatrix>& y) {
+	for (int i=0; i<x.size(); ++i) {
+		y[i] += a*x[i];
+	}
+}
+
+
+int solveBiCGStab(MixedFactorization& factorization, dcomplex z,
+		          std::vector<CDMatrix>& C, KrylovData& krylovData,
+		          std::vector<CDMatrix>& V, double& residual) {
+	PROFILE_SCOPE("solveBiCGStab");
+	int N = C.size();
+	double normC = blockNorm(C);
+
+	// right preconditioning, so that r is the residual of V itself
+	std::vector<CDMatrix> r, rHat, p, v, y, s, t, u;
+	multiplyMixed(factorization, z, V, r);
+	for (int i=0; i<N; ++i) {
+		r[i] = C[i] - r[i];
+	}
+	residual = blockNorm(r)/normC;
+	if (residual < krylovData.tolerance) return 0;
+
+	rHat = r;
+	p = r;
+	dcomplex rho = innerProduct(rHat, r);
+	for (int iteration=1; iteration<=krylovData.maxIterations; ++iteration) {
+		solveMixed(factorization, p, y);
+		multiplyMixed(factorization, z, y, v);
+		dcomplex rHatV = innerProduct(rHat, v);
+		if (rHatV == dcomplex(0.0, 0.0)) return -1;
+		dcomplex alpha = rho/rHatV;
+
+		s = r;
+		addScaled(-alpha, v, s);
+		addScaled(alpha, y, V);
+		residual = blockNorm(s)/normC;
+		if (residual < krylovData.tolerance) return iteration;
+
+		solveMixed(factorization, s, u);
+		multiplyMixed(factorization, z, u, t);
+		double tt = blockNorm(t);
+		dcomplex omega = innerProduct(t, s)/(tt*tt);
+		addScaled(omega, u, V);
+		r = s;
+		addScaled(-omega, t, r);
+		residual = blockNorm(r)/normC;
+		if (residual < krylovData.tolerance) return iteration;
+
+		dcomplex rhoNew = innerProduct(rHat, r);
+		if (rhoNew == dcomplex(0.0, 0.0) || omega == dcomplex(0.0, 0.0)) return -1;
+		dcomplex beta = (rhoNew/rho)*(alpha/omega);
+		rho = rhoNew;
+		// p = r + beta*(p - omega*v)
+		addScaled(-omega, v, p);
+		for (int i=0; i<N; ++i) {
+			p[i] = r[i] + beta*p[i];
+		}
+	}
+	return -1;
+}
+
+
+void calculateGreenFuncWarm(LatticeShape& lattice, Basis& finalSites,
+		                    Basis& initialSites,
+		                    InteractionData& interactionData,
+		                    const std::vector<dcomplex>& zList,
+		                    KrylovData& krylovData,
+		                    std::vector<dcomplex>& gfList,
+		                    std::vector<int>& iterationList,
+		                    int& numFactorizations) {
+	RecursionData recursionData;
+	setUpRecursion(lattice, interactionData, initialSites, recursionData);
+
+	int maxDistance = interactionData.maxDistance;
+	int Kfinal = findCorrespondingVK(lattice, maxDistance, finalSites);
+	int rowIndex = getBasisIndexInVK(lattice, Kfinal, finalSites);
+	int finalBlock = (Kfinal-recursionData.KLeftStart)/maxDistance;
+
+	MixedFactorization factorization;
+	std::vector<CDMatrix> C, V;
+	numFactorizations = 0;
+	gfList.clear();
+	iterationList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		dcomplex z = zList[i];
+		int iterations = -1;
+		double residual;
+		if (numFactorizations > 0) {
+			// start from the solution of the previous energy
+			iterations = solveBiCGStab(factorization, z, C, krylovData, V, residual);
+		}
+		if (iterations < 0) {
+			factorizeMixed(recursionData, z, factorization);
+			++numFactorizations;
+			if (C.empty()) {
+				C.resize(factorization.numBlocks);
+				for (int j=0; j<factorization.numBlocks; ++j) {
+					C[j] = CDMatrix::Zero(factorization.factors[j].rows(), 1);
+				}
+				C[factorization.center](recursionData.indexForNonzero, 0) = dcomplex(1.0, 0.0);
+			}
+			solveMixed(factorization, C, V);
+			iterations = solveBiCGStab(factorization, z, C, krylovData, V, residual);
+			if (iterations < 0) {
+				// not even from the new factorization: solve this z directly
+				std::vector<dcomplex> zDirect(1, z);
+				std::vector<dcomplex> gfDirect;
+				calculateGreenFunc(lattice, finalSites, initialSites,
+						interactionData, zDirect, gfDirect);
+				gfList.push_back(gfDirect[0]);
+				iterationList.push_back(-1);
+				continue;
+			}
+		}
+		gfList.push_back(V[finalBlock](rowIndex, 0));
+		iterationList.push_back(iterations);
+	}
+}
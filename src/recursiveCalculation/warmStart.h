@@ -0,0 +1,68 @@
+/*
+ * warmStart.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Green's functions on a dense energy grid from a factorization at a nearby
+ * energy.
+ *
+ * M_K(z) = W_K(z) - beta_K*A_{K+}(z) changes little between neighboring
+ * energies, but the right-hand sides alpha_K of the recursion are as wide
+ * as M_K, so reusing M_K(z0) inside the recursion would cost as much as a new
+ * factorization. Instead, the whole system H(z)*V = C (a single column, see
+ * mixedPrecision.h) is solved with BiCGStab, preconditioned by the
+ * factorization of H(z0) and started from V of the previous energy. Every
+ * iteration is O(N*n^2), against O(N*n^3) for a factorization. With
+ * |z - z0| << Im(z) the preconditioned operator is close to the identity
+ * and a few iterations are enough.
+ *
+ * When BiCGStab does not converge within maxIterations, H is factorized
+ * again at the current energy, which becomes the new z0. If it does not
+ * converge from that factorization either, the energy is solved directly
+ * with the double-precision recursion (calculateGreenFunc).
+ */
+
+#ifndef WARMSTART_H_
+#define WARMSTART_H_
+
+#include "mixedPrecision.h"
+
+
+typedef struct {
+	int maxIterations; // of BiCGStab before the factorization is renewed
+	double tolerance;  // on the relative residual |C - H*V|/|C|
+} KrylovData;
+
+
+/**
+ * BiCGStab for H(z)*V = C preconditioned with the factorization; V is the
+ * initial guess on input. Returns the number of iterations, or -1 if the
+ * tolerance is not met within maxIterations (residual is the relative
+ * residual either way)
+ */
+int solveBiCGStab(MixedFactorization& factorization, dcomplex z,
+		          std::vector<CDMatrix>& C, KrylovData& krylovData,
+		          std::vector<CDMatrix>& V, double& residual);
+
+/**
+ * same as calculateGreenFunc for an energy grid (best sorted), reusing the
+ * factorization of a nearby energy
+ *
+ * iterationList --- the BiCGStab iterations of each z (-1 if the z was
+ *                   solved directly)
+ * numFactorizations --- how many times H was factorized
+ *
+ * IMPORTANT: before calling calculateGreenFuncWarm, you have to call
+ *            setUpIndexInteractions(lattice, interactionData)
+ */
+void calculateGreenFuncWarm(LatticeShape& lattice, Basis& finalSites,
+		                    Basis& initialSites,
+		                    InteractionData& interactionData,
+		                    const std::vector<dcomplex>& zList,
+		                    KrylovData& krylovData,
+		                    std::vector<dcomplex>& gfList,
+		                    std::vector<int>& iterationList,
+		                    int& numFactorizations);
+
+#endif /* WARMSTART_H_ */
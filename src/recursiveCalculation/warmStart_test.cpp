@@ -0,0 +1,76 @@
+/*
+ * warmStart_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "warmStart.h"
+
+
+TEST(CalculateGreenFuncWarm, SameAsCalculateGreenFunc) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(40);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,3,17,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(20,21);
+	Basis finalSites(12,15);
+
+	// a dense grid with dE << eta, then a jump far away
+	std::vector<dcomplex> zList;
+	for (int i=0; i<6; ++i) {
+		zList.push_back(dcomplex(0.3+0.002*i, 0.1));
+	}
+	zList.push_back(dcomplex(2.5, 0.1));
+
+	KrylovData krylovData = {4, 1e-12};
+	std::vector<dcomplex> gfList, gfWarm;
+	std::vector<int> iterationList;
+	int numFactorizations;
+	calculateGreenFunc(lattice1D, finalSites, initialSites, interactionData,
+			zList, gfList);
+	calculateGreenFuncWarm(lattice1D, finalSites, initialSites, interactionData,
+			zList, krylovData, gfWarm, iterationList, numFactorizations);
+
+	for (int i=0; i<zList.size(); ++i) {
+		EXPECT_GE(iterationList[i], 0);
+		EXPECT_NEAR(std::abs(gfWarm[i] - gfList[i]), 0.0, 1e-10*std::abs(gfList[i]));
+	}
+	// the grid reuses the first factorization, the jump needs a new one
+	EXPECT_EQ(numFactorizations, 2);
+	deleteMatrixFiles("A*.bin");
+}
+
+
+TEST(CalculateGreenFuncWarm, DirectSolveWithoutConvergence) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(30);
+	InteractionData interactionData = {3.0,1.0,1.0,true,false,true,2,17,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+	Basis initialSites(15,16);
+	Basis finalSites(10,12);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.3, 0.1));
+	zList.push_back(dcomplex(0.31, 0.1));
+
+	// no BiCGStab iteration is allowed, so every z falls back to the
+	// double-precision recursion
+	KrylovData krylovData = {0, 1e-12};
+	std::vector<dcomplex> gfList, gfWarm;
+	std::vector<int> iterationList;
+	int numFactorizations;
+	calculateGreenFunc(lattice1D, finalSites, initialSites, interactionData,
+			zList, gfList);
+	calculateGreenFuncWarm(lattice1D, finalSites, initialSites, interactionData,
+			zList, krylovData, gfWarm, iterationList, numFactorizations);
+
+	ASSERT_EQ(gfWarm.size(), zList.size());
+	for (int i=0; i<zList.size(); ++i) {
+		EXPECT_EQ(iterationList[i], -1);
+		EXPECT_NEAR(std::abs(gfWarm[i] - gfList[i]), 0.0, 1e-12*std::abs(gfList[i]));
+	}
+	EXPECT_EQ(numFactorizations, 2);
+	deleteMatrixFiles("A*.bin");
+}
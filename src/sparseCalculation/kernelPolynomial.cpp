@@ -0,0 +1,261 @@
+/*
+ * kernelPolynomial.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "kernelPolynomial.h"
+
+
+/**
+ * find scale and shift such that the spectrum of H is mapped into
+ * [-1+epsilon/2, 1-epsilon/2]. The bounds of the spectrum are estimated from
+ * the Gershgorin circle theorem.
+ */
+void kpmScaling(DSparseMatrix& hamiltonian, KPMScaling& scaling, double epsilon) {
+	double Emin, Emax;
+	spectralBounds(hamiltonian, Emin, Emax);
+	scaling.scale = (Emax - Emin)/(2.0 - epsilon);
+	scaling.shift = (Emax + Emin)/2.0;
+	// H is proportional to the identity matrix
+	if (scaling.scale<=0.0) {
+		scaling.scale = 1.0;
+	}
+}
+
+
+/**
+ * calculate the Chebyshev moments mu_n = <start| T_n(HTilde) |start>
+ *
+ * We use the recursion of the Chebyshev polynomials
+ *      |a_0> = |start>,   |a_1> = HTilde |a_0>,
+ *      |a_{n+1}> = 2*HTilde |a_n> - |a_{n-1}>
+ * together with the product relations
+ *      mu_{2n}   = 2 <a_n|a_n> - mu_0
+ *      mu_{2n+1} = 2 <a_{n+1}|a_n> - mu_1
+ * so that numMoments moments only need numMoments/2 matrix-vector products.
+ */
+void kpmMoments(DSparseMatrix& hamiltonian, KPMScaling& scaling, DVector& start,
+		        int numMoments, DVector& moments) {
+	moments = DVector::Zero(numMoments);
+	double scale = scaling.scale;
+	double shift = scaling.shift;
+
+	DVector aPrevious = start;
+	DVector aCurrent(start.size());
+	DVector aNext(start.size());
+
+	// |a_1> = HTilde |a_0>
+	aCurrent.noalias() = hamiltonian*aPrevious;
+	aCurrent = (aCurrent - shift*aPrevious)/scale;
+
+	double mu0 = aPrevious.dot(aPrevious);
+	double mu1 = aCurrent.dot(aPrevious);
+	moments(0) = mu0;
+	if (numMoments>1) {
+		moments(1) = mu1;
+	}
+
+	for (int n=1; 2*n<numMoments; ++n) {
+		// |a_{n+1}> = 2*HTilde |a_n> - |a_{n-1}>
+		aNext.noalias() = hamiltonian*aCurrent;
+		aNext = 2.0*(aNext - shift*aCurrent)/scale - aPrevious;
+
+		moments(2*n) = 2.0*aCurrent.dot(aCurrent) - mu0;
+		if (2*n+1<numMoments) {
+			moments(2*n+1) = 2.0*aNext.dot(aCurrent) - mu1;
+		}
+
+		aPrevious.swap(aCurrent);
+		aCurrent.swap(aNext);
+	}
+}
+
+
+/**
+ * stochastic evaluation of Tr[T_n(HTilde)]/N_basis
+ *
+ * For random vectors |r> with elements +1 or -1, the average of <r|A|r> is
+ * Tr[A]. The statistical error decreases as 1/sqrt(numRandom*N_basis).
+ */
+void kpmMomentsStochastic(DSparseMatrix& hamiltonian, KPMScaling& scaling,
+		                  int numMoments, int numRandom, unsigned seed,
+		                  DVector& moments) {
+	int size = hamiltonian.rows();
+	RandomNumberGenerator rng(seed);
+
+	moments = DVector::Zero(numMoments);
+	for (int r=0; r<numRandom; ++r) {
+		DVector start(size);
+		for (int i=0; i<size; ++i) {
+			start(i) = (rng.randomReal()<0.5)?-1.0:1.0;
+		}
+		DVector momentsOfOneVector;
+		kpmMoments(hamiltonian, scaling, start, numMoments, momentsOfOneVector);
+		moments += momentsOfOneVector;
+	}
+	moments /= double(numRandom)*size;
+}
+
+
+/**
+ * the Jackson kernel
+ *
+ * g_n = [ (N-n+1)*cos(Pi*n/(N+1)) + sin(Pi*n/(N+1))*cot(Pi/(N+1)) ]/(N+1)
+ *
+ * where N = numMoments. The resulting resolution is about Pi*scale/N.
+ */
+void jacksonKernel(int numMoments, DVector& kernel) {
+	kernel = DVector(numMoments);
+	double N = numMoments;
+	double q = M_PI/(N+1);
+	for (int n=0; n<numMoments; ++n) {
+		kernel(n) = ( (N-n+1)*std::cos(q*n) + std::sin(q*n)/std::tan(q) )/(N+1);
+	}
+}
+
+
+/**
+ * the weights w_n = c_n*g_n*T_n(x)/(scale*Pi*sqrt(1-x^2)) (c_0=1, c_n=2)
+ * such that rho(E) = sum_n w_n*mu_n
+ *
+ * the weights are zero if E is outside the (rescaled) spectrum
+ */
+static void kpmWeights(DVector& kernel, KPMScaling& scaling, double energy,
+		               DVector& weights) {
+	int numMoments = kernel.size();
+	weights = DVector::Zero(numMoments);
+	double x = (energy - scaling.shift)/scaling.scale;
+	if (x<=-1.0 || x>=1.0) {
+		return;
+	}
+
+	double prefactor = 1.0/(scaling.scale*M_PI*std::sqrt(1.0 - x*x));
+	double TPrevious = 1.0; // T_0(x)
+	double TCurrent = x;    // T_1(x)
+	weights(0) = prefactor*kernel(0);
+	for (int n=1; n<numMoments; ++n) {
+		weights(n) = 2.0*prefactor*kernel(n)*TCurrent;
+		double TNext = 2.0*x*TCurrent - TPrevious;
+		TPrevious = TCurrent;
+		TCurrent = TNext;
+	}
+}
+
+
+/**
+ * reconstruct the density of state at the given energies from the moments
+ */
+void kpmDensityOfState(DVector& moments, KPMScaling& scaling,
+		               const std::vector<double>& energyList,
+		               std::vector<double>& dosList) {
+	DVector kernel;
+	jacksonKernel(moments.size(), kernel);
+
+	dosList.clear();
+	for (int i=0; i<energyList.size(); ++i) {
+		DVector weights;
+		kpmWeights(kernel, scaling, energyList[i], weights);
+		dosList.push_back( weights.dot(moments) );
+	}
+}
+
+
+/**
+ * calculate the density of state at (site1, site2) for a list of energies
+ */
+void densityOfState_kpm(LatticeShape& lattice, Basis& basis,
+		                const std::vector<double>& energyList,
+		                std::vector<double>& dosList, int numMoments) {
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DSparseMatrix hamiltonian;
+	formSparseHamiltonian(lattice, hamiltonian, basisIndex, basisSets);
+
+	KPMScaling scaling;
+	kpmScaling(hamiltonian, scaling);
+
+	DVector start = DVector::Zero(basisSets.size());
+	start(getBasisPosition(lattice, basis, basisIndex)) = 1.0;
+
+	DVector moments;
+	kpmMoments(hamiltonian, scaling, start, numMoments, moments);
+	kpmDensityOfState(moments, scaling, energyList, dosList);
+}
+
+
+/**
+ * calculate the density of state (per basis state) of the whole system
+ */
+void totalDensityOfState_kpm(LatticeShape& lattice,
+		                     const std::vector<double>& energyList,
+		                     std::vector<double>& dosList, int numMoments,
+		                     int numRandom, unsigned seed) {
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DSparseMatrix hamiltonian;
+	formSparseHamiltonian(lattice, hamiltonian, basisIndex, basisSets);
+
+	KPMScaling scaling;
+	kpmScaling(hamiltonian, scaling);
+
+	DVector moments;
+	kpmMomentsStochastic(hamiltonian, scaling, numMoments, numRandom, seed, moments);
+	kpmDensityOfState(moments, scaling, energyList, dosList);
+}
+
+
+/**
+ * calculate the density of state at all sites for a list of energies
+ *
+ * moments(nth, n) is the n-th moment of the nth basis set. Once it is known,
+ * the density of state of all sites at one energy is a single matrix-vector
+ * product moments*weights.
+ */
+void densityOfStateAll_kpm(LatticeShape& lattice,
+		                   const std::vector<double>& energyList,
+		                   std::vector<std::string>& fileList, int numMoments) {
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DSparseMatrix hamiltonian;
+	formSparseHamiltonian(lattice, hamiltonian, basisIndex, basisSets);
+
+	KPMScaling scaling;
+	kpmScaling(hamiltonian, scaling);
+
+	int size = basisSets.size();
+	DMatrix moments(size, numMoments);
+
+	// every site is independent of the others
+	#pragma omp parallel for schedule(dynamic)
+	for (int nth=0; nth<size; ++nth) {
+		DVector start = DVector::Zero(size);
+		start(nth) = 1.0;
+		DVector momentsOfOneSite;
+		kpmMoments(hamiltonian, scaling, start, numMoments, momentsOfOneSite);
+		moments.row(nth) = momentsOfOneSite.transpose();
+	}
+
+	DVector kernel;
+	jacksonKernel(numMoments, kernel);
+
+	for (int i=0; i<energyList.size(); ++i) {
+		DVector weights;
+		kpmWeights(kernel, scaling, energyList[i], weights);
+		DVector rho = moments*weights;
+
+		// note the following is for the 1D case only
+		int xmax = lattice.getXmax();
+		DMatrix dos = DMatrix::Zero(xmax+1, xmax+1);
+		for (int nth=0; nth<size; ++nth) {
+			int n1 = basisSets[nth][0];
+			int n2 = basisSets[nth][1];
+			dos(n1, n2) = rho(nth);
+			dos(n2, n1) = rho(nth);
+		}
+
+		// save dos into file
+		saveMatrixText(fileList[i], dos);
+	}
+}
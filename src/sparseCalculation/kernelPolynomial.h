@@ -0,0 +1,113 @@
+/*
+ * kernelPolynomial.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#ifndef KERNELPOLYNOMIAL_H_
+#define KERNELPOLYNOMIAL_H_
+
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../Utility/random_generator.h"
+#include "../basis_set/basis.h"
+#include "../IO/textIO.h"
+#include "sparseHamiltonian.h"
+
+/**
+ * Kernel polynomial method (KPM)
+ *
+ * The Hamiltonian is rescaled into [-1, 1]:  HTilde = (H - shift)/scale, and
+ * the density of state is expanded in Chebyshev polynomials T_n:
+ *
+ *                          1               /                 N-1                 \
+ *  rho(E) = ----------------------------- | g_0*mu_0 + 2*sum   g_n*mu_n*T_n(x)  |
+ *            scale*Pi*sqrt(1 - x^2)        \                 n=1                 /
+ *
+ * where x = (E - shift)/scale, mu_n = <v| T_n(HTilde) |v> are the Chebyshev
+ * moments and g_n is the Jackson kernel that damps the Gibbs oscillations.
+ *
+ * The moments only need to be calculated once. After that, the density of
+ * state can be evaluated for any number of energies at the cost of
+ * O(numMoments) per energy.
+ */
+typedef struct {
+	double scale;
+	double shift;
+} KPMScaling;
+
+/**
+ * find scale and shift such that the spectrum of H is mapped into
+ * [-1+epsilon/2, 1-epsilon/2]
+ */
+void kpmScaling(DSparseMatrix& hamiltonian, KPMScaling& scaling, double epsilon=0.01);
+
+/**
+ * calculate the Chebyshev moments mu_n = <start| T_n(HTilde) |start>,
+ * n = 0, 1, ..., numMoments-1
+ */
+void kpmMoments(DSparseMatrix& hamiltonian, KPMScaling& scaling, DVector& start,
+		        int numMoments, DVector& moments);
+
+/**
+ * stochastic evaluation of the normalized trace Tr[T_n(HTilde)]/N_basis
+ * averaged over numRandom random vectors whose elements are +1 or -1
+ */
+void kpmMomentsStochastic(DSparseMatrix& hamiltonian, KPMScaling& scaling,
+		                  int numMoments, int numRandom, unsigned seed,
+		                  DVector& moments);
+
+/**
+ * the Jackson kernel g_n (n = 0, 1, ..., numMoments-1)
+ */
+void jacksonKernel(int numMoments, DVector& kernel);
+
+/**
+ * reconstruct the density of state at the given energies from the moments
+ */
+void kpmDensityOfState(DVector& moments, KPMScaling& scaling,
+		               const std::vector<double>& energyList,
+		               std::vector<double>& dosList);
+
+/**
+ * calculate the density of state at (site1, site2) for a list of energies
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void densityOfState_kpm(LatticeShape& lattice, Basis& basis,
+		                const std::vector<double>& energyList,
+		                std::vector<double>& dosList, int numMoments=1000);
+
+/**
+ * calculate the density of state (per basis state) of the whole system with
+ * the stochastic trace
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void totalDensityOfState_kpm(LatticeShape& lattice,
+		                     const std::vector<double>& energyList,
+		                     std::vector<double>& dosList, int numMoments=1000,
+		                     int numRandom=20, unsigned seed=100);
+
+/**
+ * calculate the density of state at all sites for a list of energies and save
+ * the result into an array of files (one file for one energy), in the same
+ * format as densityOfStateAll_direct
+ *
+ * The moments of all sites are calculated once (in parallel), so the cost of
+ * each additional energy is only O(N_basis*numMoments).
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void densityOfStateAll_kpm(LatticeShape& lattice,
+		                   const std::vector<double>& energyList,
+		                   std::vector<std::string>& fileList, int numMoments=1000);
+
+#endif /* KERNELPOLYNOMIAL_H_ */
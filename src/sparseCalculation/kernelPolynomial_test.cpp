@@ -0,0 +1,107 @@
+/*
+ * kernelPolynomial_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "kernelPolynomial.h"
+#include "../directCalculation/direct_calculation.h"
+
+
+/**
+ * compare the Chebyshev moments with the ones obtained from the eigenvectors
+ *     mu_n = sum_k |<basis|k>|^2 T_n( (E_k - shift)/scale )
+ */
+TEST(KernelPolynomialTest, MomentsFromEigenVectors) {
+	LatticeShape lattice1D(1);
+	int xmax = 20;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,false,2,230,true,true};
+	generateIndexMatrix(lattice1D);
+	setLatticeAndInteractions(lattice1D, interactionData);
+
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DSparseMatrix hamiltonian;
+	formSparseHamiltonian(lattice1D, hamiltonian, basisIndex, basisSets);
+
+	KPMScaling scaling;
+	kpmScaling(hamiltonian, scaling);
+
+	Basis basis(xmax/2, xmax/2+1);
+	int nth = getBasisPosition(lattice1D, basis, basisIndex);
+	DVector start = DVector::Zero(basisSets.size());
+	start(nth) = 1.0;
+
+	int numMoments = 51;
+	DVector moments;
+	kpmMoments(hamiltonian, scaling, start, numMoments, moments);
+
+	DMatrix denseHamiltonian = DMatrix(hamiltonian);
+	DVector eigenValues;
+	DMatrix eigenVectors;
+	obtainEigenVectors(denseHamiltonian, eigenValues, eigenVectors);
+
+	for (int n=0; n<numMoments; ++n) {
+		double exact = 0.0;
+		for (int k=0; k<eigenValues.size(); ++k) {
+			double x = (eigenValues(k) - scaling.shift)/scaling.scale;
+			double weight = eigenVectors(nth, k)*eigenVectors(nth, k);
+			exact += weight*std::cos(n*std::acos(x));
+		}
+		EXPECT_NEAR(moments(n), exact, 1.e-10);
+	}
+}
+
+
+/**
+ * the local density of state must be normalized to one, and the result for
+ * all sites must agree with the one for a single site
+ */
+TEST(KernelPolynomialTest, NormalizationAndAllSites) {
+	LatticeShape lattice1D(1);
+	int xmax = 20;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	InteractionData interactionData = {0.0,1.0,1.0,true,false,false,2,230,true,true};
+	generateIndexMatrix(lattice1D);
+	setLatticeAndInteractions(lattice1D, interactionData);
+
+	int size = 4001;
+	std::vector<double> energyList = linspace(-10, 10, size);
+	double dE = energyList[1] - energyList[0];
+
+	Basis basis(xmax/2, xmax/2+3);
+	std::vector<double> dosList;
+	densityOfState_kpm(lattice1D, basis, energyList, dosList, 256);
+	double integral = 0.0;
+	for (int i=0; i<dosList.size(); ++i) {
+		integral += dosList[i]*dE;
+	}
+	EXPECT_NEAR(integral, 1.0, 1.e-3);
+
+	std::vector<double> totalDosList;
+	totalDensityOfState_kpm(lattice1D, energyList, totalDosList, 256, 10, 100);
+	integral = 0.0;
+	for (int i=0; i<totalDosList.size(); ++i) {
+		integral += totalDosList[i]*dE;
+	}
+	EXPECT_NEAR(integral, 1.0, 1.e-2);
+
+	std::vector<double> fewEnergies;
+	fewEnergies.push_back(-1.0);
+	fewEnergies.push_back(0.5);
+	std::vector<std::string> fileList;
+	fileList.push_back("dos_kpm_0.txt");
+	fileList.push_back("dos_kpm_1.txt");
+	densityOfStateAll_kpm(lattice1D, fewEnergies, fileList, 256);
+	densityOfState_kpm(lattice1D, basis, fewEnergies, dosList, 256);
+	for (int i=0; i<fewEnergies.size(); ++i) {
+		// the text file only keeps a few significant digits
+		DMatrix dos;
+		loadMatrixText(fileList[i], dos);
+		EXPECT_NEAR(dos(basis[0], basis[1]), dosList[i], 1.e-5);
+		EXPECT_NEAR(dos(basis[1], basis[0]), dosList[i], 1.e-5);
+	}
+}
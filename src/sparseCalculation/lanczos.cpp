@@ -0,0 +1,142 @@
+/*
+ * lanczos.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#include "lanczos.h"
+
+
+/**
+ * Lanczos recursion (without reorthogonalization)
+ *
+ * The loss of orthogonality only produces spurious copies of the converged
+ * eigenvalues, whose weights add up to the correct ones, so the continued
+ * fraction built from a and b is still accurate.
+ */
+void lanczosCoefficients(DSparseMatrix& hamiltonian, DVector& start, int numSteps,
+		                 DVector& a, DVector& b) {
+	int size = hamiltonian.rows();
+	// the Krylov space can't be larger than the Hilbert space
+	numSteps = min(numSteps, size);
+
+	a = DVector::Zero(numSteps);
+	b = DVector::Zero(numSteps);
+
+	DVector uPrevious = DVector::Zero(size);
+	DVector u = start/start.norm();
+	DVector w(size);
+
+	int steps = numSteps;
+	for (int j=0; j<numSteps; ++j) {
+		w.noalias() = hamiltonian*u;
+		a(j) = u.dot(w);
+		w -= a(j)*u;
+		if (j>0) {
+			w -= b(j-1)*uPrevious;
+		}
+		b(j) = w.norm();
+
+		// the Krylov space is exhausted, the continued fraction terminates
+		if (b(j) <= 1.0e-12*(std::fabs(a(j)) + 1.0)) {
+			b(j) = 0.0;
+			steps = j+1;
+			break;
+		}
+
+		uPrevious.swap(u);
+		u = w/b(j);
+	}
+
+	// only keep the coefficients that have been calculated
+	a.conservativeResize(steps);
+	b.conservativeResize(steps);
+}
+
+
+/**
+ * evaluate the continued fraction from the bottom to the top
+ */
+dcomplex continuedFraction(dcomplex z, DVector& a, DVector& b, double norm2) {
+	int n = a.size();
+	dcomplex result = dcomplex(0.0, 0.0);
+	for (int j=n-1; j>=0; --j) {
+		double bj2 = (j<n-1)?b(j)*b(j):0.0;
+		result = 1.0/(z - a(j) - bj2*result);
+	}
+	return norm2*result;
+}
+
+
+
+/**
+ * calculate <bra | G(z) | ket> for a list of z values (see lanczos.h)
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void greenFunc_lanczos(LatticeShape& lattice, Basis& bra, Basis& ket,
+		               std::vector<dcomplex >& zList, std::vector<dcomplex>& gfList,
+		               int numSteps) {
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DSparseMatrix hamiltonian;
+	formSparseHamiltonian(lattice, hamiltonian, basisIndex, basisSets);
+
+	int size = basisSets.size();
+	int braIndex = getBasisPosition(lattice, bra, basisIndex);
+	int ketIndex = getBasisPosition(lattice, ket, basisIndex);
+
+	// <ket|G|ket>
+	DVector start = DVector::Zero(size);
+	start(ketIndex) = 1.0;
+	DVector aKet, bKet;
+	lanczosCoefficients(hamiltonian, start, numSteps, aKet, bKet);
+
+	gfList.clear();
+	if (braIndex==ketIndex) {
+		for (int i=0; i<zList.size(); ++i) {
+			gfList.push_back(continuedFraction(zList[i], aKet, bKet, 1.0));
+		}
+		return;
+	}
+
+	// <bra|G|bra>
+	start.setZero();
+	start(braIndex) = 1.0;
+	DVector aBra, bBra;
+	lanczosCoefficients(hamiltonian, start, numSteps, aBra, bBra);
+
+	// <+|G|+> with |+> = |bra> + |ket>
+	start(ketIndex) = 1.0;
+	DVector aPlus, bPlus;
+	lanczosCoefficients(hamiltonian, start, numSteps, aPlus, bPlus);
+
+	for (int i=0; i<zList.size(); ++i) {
+		dcomplex z = zList[i];
+		dcomplex gPlus = continuedFraction(z, aPlus, bPlus, 2.0);
+		dcomplex gBra = continuedFraction(z, aBra, bBra, 1.0);
+		dcomplex gKet = continuedFraction(z, aKet, bKet, 1.0);
+		gfList.push_back( (gPlus - gBra - gKet)/2.0 );
+	}
+}
+
+
+
+/**
+ * calculate the density of state at (site1, site2)
+ * density_of_state = -Im(<basis | G(z) | basis>)/Pi
+ */
+void densityOfState_lanczos(LatticeShape& lattice, Basis& basis,
+		                    std::vector<dcomplex >& zList, std::vector<double>& dosList,
+		                    int numSteps) {
+	std::vector<dcomplex> gfList;
+	greenFunc_lanczos(lattice, basis, basis, zList, gfList, numSteps);
+
+	dosList.clear();
+	for (int i=0; i<gfList.size(); ++i) {
+		dosList.push_back( -gfList[i].imag()/M_PI );
+	}
+}
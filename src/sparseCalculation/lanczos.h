@@ -0,0 +1,72 @@
+/*
+ * lanczos.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#ifndef LANCZOS_H_
+#define LANCZOS_H_
+
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../basis_set/basis.h"
+#include "sparseHamiltonian.h"
+
+/**
+ * Run the Lanczos recursion on H starting from the vector "start"
+ *
+ *     H |u_j> = b_{j-1} |u_{j-1}> + a_j |u_j> + b_j |u_{j+1}>
+ *
+ * with |u_0> = |start>/|| start ||. The diagonal (a) and off-diagonal (b)
+ * elements of the tridiagonal matrix are returned. The recursion stops early
+ * if the Krylov space is exhausted (b_j = 0).
+ */
+void lanczosCoefficients(DSparseMatrix& hamiltonian, DVector& start, int numSteps,
+		                 DVector& a, DVector& b);
+
+/**
+ * evaluate <start| G(z) |start> from the Lanczos coefficients
+ *
+ *                           norm2
+ *   G(z) = -------------------------------------
+ *                               b_0^2
+ *           z - a_0 - ---------------------------
+ *                                   b_1^2
+ *                       z - a_1 - --------------
+ *                                   z - a_2 - ...
+ *
+ * where norm2 = <start|start>
+ */
+dcomplex continuedFraction(dcomplex z, DVector& a, DVector& b, double norm2);
+
+/**
+ * calculate the Green function <bra | G(z) | ket> for a list of z values
+ * from (at most) three Krylov runs, one for each of |bra>, |ket> and
+ * |bra> + |ket> (polarization identity, H is real symmetric):
+ *
+ * <bra|G|ket> = ( <+|G|+> - <bra|G|bra> - <ket|G|ket> )/2,  |+> = |bra>+|ket>
+ *
+ * If bra == ket, only one Krylov run is needed.
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void greenFunc_lanczos(LatticeShape& lattice, Basis& bra, Basis& ket,
+		               std::vector<dcomplex >& zList, std::vector<dcomplex>& gfList,
+		               int numSteps=300);
+
+/**
+ * calculate the density of state at (site1, site2)
+ * density_of_state = -Im(<basis | G(z) | basis>)/Pi
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void densityOfState_lanczos(LatticeShape& lattice, Basis& basis,
+		                    std::vector<dcomplex >& zList, std::vector<double>& dosList,
+		                    int numSteps=300);
+
+#endif /* LANCZOS_H_ */
@@ -0,0 +1,131 @@
+/*
+ * lanczos_test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "lanczos.h"
+#include "../directCalculation/direct_calculation.h"
+
+
+/**
+ * the sparse Hamiltonian must be identical to the dense one
+ */
+TEST(SparseHamiltonian, SameAsDense) {
+	LatticeShape lattice1D(1);
+	int xmax = 30;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	InteractionData interactionData = {1.0,1.0,2.0,true,true,true,3,230,true,true};
+	generateIndexMatrix(lattice1D);
+	setLatticeAndInteractions(lattice1D, interactionData);
+
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DMatrix hamiltonian;
+	formAllBasisSets(lattice1D, basisIndex, basisSets);
+	formHamiltonianMatrix(lattice1D, hamiltonian, basisIndex, basisSets);
+
+	IMatrix sparseBasisIndex;
+	std::vector<Basis> sparseBasisSets;
+	DSparseMatrix sparseHamiltonian;
+	formSparseHamiltonian(lattice1D, sparseHamiltonian, sparseBasisIndex,
+			              sparseBasisSets);
+
+	EXPECT_EQ(hamiltonian.rows(), sparseHamiltonian.rows());
+	EXPECT_EQ(hamiltonian.cols(), sparseHamiltonian.cols());
+	DMatrix difference = hamiltonian - DMatrix(sparseHamiltonian);
+	EXPECT_NEAR(difference.norm(), 0.0, 1.e-12);
+}
+
+
+/**
+ * compare the Lanczos continued fraction with the direct calculation
+ */
+TEST(LanczosTest, CompareWithDirect) {
+	LatticeShape lattice1D(1);
+	int xmax = 30;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,false,2,230,true,true};
+	generateIndexMatrix(lattice1D);
+	setLatticeAndInteractions(lattice1D, interactionData);
+
+	int size = 41;
+	std::vector<dcomplex > zList(size);
+	std::vector<double> zRealList = linspace(-10,10,size);
+	for (int i=0; i<zList.size(); ++i) {
+		zList[i] = dcomplex(zRealList[i], 0.1);
+	}
+
+	Basis initialSites(xmax/2, xmax/2+1);
+	Basis finalSites(xmax/2-3, xmax/2+4);
+
+	// the Krylov space is the whole Hilbert space
+	int numSteps = (xmax+1)*xmax/2;
+
+	// diagonal element
+	std::vector<dcomplex> gf_lanczos;
+	std::vector<dcomplex> gf_direct;
+	greenFunc_lanczos(lattice1D, initialSites, initialSites, zList,
+			          gf_lanczos, numSteps);
+	greenFunc_direct(lattice1D, initialSites, initialSites, zList, gf_direct);
+
+	EXPECT_EQ(gf_lanczos.size(), gf_direct.size());
+	double abs_error = 1.e-8;
+	for (int i=0; i<gf_lanczos.size(); ++i) {
+		EXPECT_NEAR(gf_lanczos[i].real(), gf_direct[i].real(), abs_error);
+		EXPECT_NEAR(gf_lanczos[i].imag(), gf_direct[i].imag(), abs_error);
+	}
+
+	// off-diagonal element
+	greenFunc_lanczos(lattice1D, finalSites, initialSites, zList,
+			          gf_lanczos, numSteps);
+	greenFunc_direct(lattice1D, finalSites, initialSites, zList, gf_direct);
+
+	for (int i=0; i<gf_lanczos.size(); ++i) {
+		EXPECT_NEAR(gf_lanczos[i].real(), gf_direct[i].real(), abs_error);
+		EXPECT_NEAR(gf_lanczos[i].imag(), gf_direct[i].imag(), abs_error);
+	}
+}
+
+
+/**
+ * a Krylov space much smaller than the Hilbert space already converges when
+ * the broadening is larger than the spacing of the Lanczos poles
+ */
+TEST(LanczosTest, ConvergesWithFewSteps) {
+	LatticeShape lattice1D(1);
+	int xmax = 50;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,false,2,230,true,true};
+	generateIndexMatrix(lattice1D);
+	setLatticeAndInteractions(lattice1D, interactionData);
+
+	std::vector<dcomplex> zList;
+	std::vector<double> zRealList = linspace(-6,6,13);
+	for (int i=0; i<zRealList.size(); ++i) {
+		zList.push_back(dcomplex(zRealList[i], 0.5));
+	}
+	Basis initialSites(xmax/2, xmax/2+1);
+	Basis finalSites(xmax/2-3, xmax/2+4);
+
+	int numSteps = 80;
+	// 80 steps against 1275 basis states; the error at 80 steps is ~3e-9
+	std::vector<dcomplex> gf_lanczos, gf_direct;
+	greenFunc_lanczos(lattice1D, initialSites, initialSites, zList,
+			          gf_lanczos, numSteps);
+	greenFunc_direct(lattice1D, initialSites, initialSites, zList, gf_direct);
+	ASSERT_EQ(gf_lanczos.size(), gf_direct.size());
+	double abs_error = 1.e-7;
+	for (int i=0; i<zList.size(); ++i) {
+		EXPECT_NEAR(std::abs(gf_lanczos[i]-gf_direct[i]), 0.0, abs_error);
+	}
+
+	greenFunc_lanczos(lattice1D, finalSites, initialSites, zList,
+			          gf_lanczos, numSteps);
+	greenFunc_direct(lattice1D, finalSites, initialSites, zList, gf_direct);
+	for (int i=0; i<zList.size(); ++i) {
+		EXPECT_NEAR(std::abs(gf_lanczos[i]-gf_direct[i]), 0.0, abs_error);
+	}
+}
@@ -0,0 +1,103 @@
+/*
+ * sparseHamiltonian.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#include "sparseHamiltonian.h"
+
+
+/**
+ * form the two-particle Hamiltonian as a sparse matrix
+ *
+ * It is filled in the same way as formHamiltonianMatrix: for each ket we
+ * generate its neighbors at distance +/-1, ..., +/-maxDistance and record
+ * <bra|H|ket> as a triplet (row, col, value).
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void formSparseHamiltonian(LatticeShape& lattice, DSparseMatrix& hamiltonian,
+		                   IMatrix& basisIndex, std::vector<Basis>& basisSets) {
+	extern Interaction *pInteraction;
+	formAllBasisSets(lattice, basisIndex, basisSets);
+
+	int size = basisSets.size();
+	int maxDistance = pInteraction->getMaxDistance();
+
+	std::vector<DTriplet> triplets;
+	// at most 4 neighbors at each distance plus the diagonal element
+	triplets.reserve(size*(4*maxDistance+1));
+
+	for (int col=0; col<size; ++col) {
+		Basis ket = basisSets[col];
+
+		// the diagonal part: keep it even if it is zero, so that the sparsity
+		// pattern always contains the diagonal (needed for z - H)
+		triplets.push_back(DTriplet(col, col, pInteraction->onsiteE(ket)
+				                              + pInteraction->dyn(ket)));
+
+		// the off-diagonal part
+		int bra_site1;
+		int bra_site2;
+		int row;
+		for (int distance=1; distance<=maxDistance; ++distance) {
+			for (int sign=-1; sign<=1; sign+=2) {
+				Neighbors neighbors;
+				generateNeighbors(ket, sign*distance, lattice, neighbors);
+				for (int i=0; i<neighbors.size(); ++i) {
+					Basis bra = neighbors[i];
+					double element = pInteraction->hop(bra, ket);
+					if (element!=0.0) {
+						getLatticeIndex(lattice, bra, bra_site1, bra_site2);
+						row = basisIndex(bra_site1, bra_site2);
+						triplets.push_back(DTriplet(row, col, element));
+					}
+				}
+			}
+		}
+	}
+
+	hamiltonian.resize(size, size);
+	hamiltonian.setFromTriplets(triplets.begin(), triplets.end());
+	hamiltonian.makeCompressed();
+}
+
+
+/**
+ * return the position of a two-particle basis in the list of basis sets
+ * produced by formAllBasisSets
+ */
+int getBasisPosition(LatticeShape& lattice, Basis& basis, IMatrix& basisIndex) {
+	int site1, site2;
+	getLatticeIndex(lattice, basis, site1, site2);
+	// basisIndex is only filled for site1 < site2
+	return basisIndex(min(site1, site2), max(site1, site2));
+}
+
+
+/**
+ * estimate the bounds of the spectrum from the Gershgorin circle theorem
+ *
+ * every eigenvalue lies in one of the discs centered at H(i,i) with radius
+ * sum_{j!=i} |H(i,j)|. Since H is symmetric, we can go through the columns.
+ */
+void spectralBounds(DSparseMatrix& hamiltonian, double& Emin, double& Emax) {
+	Emin = std::numeric_limits<double>::max();
+	Emax = -std::numeric_limits<double>::max();
+	for (int col=0; col<hamiltonian.outerSize(); ++col) {
+		double center = 0.0;
+		double radius = 0.0;
+		for (DSparseMatrix::InnerIterator it(hamiltonian, col); it; ++it) {
+			if (it.row()==col) {
+				center = it.value();
+			} else {
+				radius += std::fabs(it.value());
+			}
+		}
+		Emin = std::min(Emin, center - radius);
+		Emax = std::max(Emax, center + radius);
+	}
+}
@@ -0,0 +1,45 @@
+/*
+ * sparseHamiltonian.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: pxiang
+ */
+
+#ifndef SPARSEHAMILTONIAN_H_
+#define SPARSEHAMILTONIAN_H_
+
+#include <algorithm>
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../basis_set/basis.h"
+#include "../formMatrix/formMatrix.h"
+#include "../directCalculation/direct_calculation.h"
+
+/**
+ * form the two-particle Hamiltonian as a sparse matrix
+ *
+ * The basis sets and their ordering are the same as those used by
+ * formHamiltonianMatrix (see formAllBasisSets), but only the nonzero elements
+ * are stored. Each column has at most 4*maxDistance+1 nonzero elements, so
+ * the memory grows as N_basis instead of N_basis^2.
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void formSparseHamiltonian(LatticeShape& lattice, DSparseMatrix& hamiltonian,
+		                   IMatrix& basisIndex, std::vector<Basis>& basisSets);
+
+/**
+ * return the position of a two-particle basis in the list of basis sets
+ * produced by formAllBasisSets
+ */
+int getBasisPosition(LatticeShape& lattice, Basis& basis, IMatrix& basisIndex);
+
+/**
+ * estimate the lower and upper bounds of the spectrum of the Hamiltonian from
+ * the Gershgorin circle theorem (all eigenvalues lie in [Emin, Emax])
+ */
+void spectralBounds(DSparseMatrix& hamiltonian, double& Emin, double& Emax);
+
+#endif /* SPARSEHAMILTONIAN_H_ */
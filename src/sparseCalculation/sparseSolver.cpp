@@ -0,0 +1,131 @@
+/*
+ * sparseSolver.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "sparseSolver.h"
+
+
+/**
+ * form the sparse Hamiltonian, and do the ordering and the symbolic
+ * factorization of z - H once and for all
+ */
+SparseGreenSolver::SparseGreenSolver(LatticeShape& lattice) {
+	pLatticeShape = &lattice;
+	formSparseHamiltonian(lattice, hamiltonian, basisIndex, basisSets);
+
+	// z - H has the same sparsity pattern as H (the diagonal is always stored)
+	zMinusH = -hamiltonian.cast<dcomplex>();
+	zMinusH.makeCompressed();
+
+	// find out where the diagonal elements are stored
+	int n = zMinusH.cols();
+	diagonalPosition.resize(n);
+	for (int col=0; col<n; ++col) {
+		int start = zMinusH.outerIndexPtr()[col];
+		int end = zMinusH.outerIndexPtr()[col+1];
+		for (int k=start; k<end; ++k) {
+			if (zMinusH.innerIndexPtr()[k]==col) {
+				diagonalPosition[col] = k;
+				break;
+			}
+		}
+	}
+
+	lu.analyzePattern(zMinusH);
+}
+
+
+/**
+ * factorize z - H for a new z, reusing the ordering and the symbolic
+ * factorization
+ */
+bool SparseGreenSolver::factorize(dcomplex z) {
+	// reset the values to -H and add z to the diagonal
+	DSparseMatrix::Scalar * hValues = hamiltonian.valuePtr();
+	dcomplex * values = zMinusH.valuePtr();
+	int nonZeros = zMinusH.nonZeros();
+	for (int k=0; k<nonZeros; ++k) {
+		values[k] = -hValues[k];
+	}
+	for (int col=0; col<diagonalPosition.size(); ++col) {
+		values[diagonalPosition[col]] += z;
+	}
+
+	lu.factorize(zMinusH);
+	if (lu.info()!=Eigen::Success) {
+		std::cout << "Sparse LU factorization failed for z = " << z << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * solve (z - H) x = e_initial, x = G(:, initial)
+ */
+void SparseGreenSolver::solveColumn(Basis& initialSites, CDVector& column) {
+	CDVector rightSide = CDVector::Zero(size());
+	rightSide(position(initialSites)) = dcomplex(1.0, 0.0);
+	column = lu.solve(rightSide);
+}
+
+
+/**
+ * put G(:, initial) into a matrix gf(n1, n2) (1D case only)
+ */
+void SparseGreenSolver::columnToMatrix(CDVector& column, CDMatrix& gf) {
+	int nsite = pLatticeShape->getXmax() + 1;
+	gf = CDMatrix::Zero(nsite, nsite);
+	for (int nth=0; nth<basisSets.size(); ++nth) {
+		int n1 = basisSets[nth][0];
+		int n2 = basisSets[nth][1];
+		gf(n1, n2) = column(nth);
+		gf(n2, n1) = column(nth);
+	}
+}
+
+
+
+/**
+ * calculate <bra | G(z) | ket> for a list of z values
+ */
+void greenFunc_sparse(LatticeShape& lattice, Basis& bra, Basis& ket,
+		              std::vector<dcomplex >& zList, std::vector<dcomplex>& gfList) {
+	SparseGreenSolver solver(lattice);
+	int braIndex = solver.position(bra);
+
+	gfList.clear();
+	for (int i=0; i<zList.size(); ++i) {
+		// a failed LU would give garbage for this and the later energies
+		if (!solver.factorize(zList[i])) exit(-1);
+		CDVector column;
+		solver.solveColumn(ket, column);
+		gfList.push_back(column(braIndex));
+	}
+}
+
+
+
+/**
+ * calculate all Green's function G(n1, n2; initialSites) and save them into
+ * files
+ */
+void calculateAllGreenFunc_sparse(LatticeShape& lattice, Basis& initialSites,
+		                          std::vector<dcomplex >& zList,
+		                          std::vector<std::string>& fileList) {
+	SparseGreenSolver solver(lattice);
+
+	for (int i=0; i<zList.size(); ++i) {
+		if (!solver.factorize(zList[i])) exit(-1);
+		CDVector column;
+		solver.solveColumn(initialSites, column);
+
+		CDMatrix gf;
+		solver.columnToMatrix(column, gf);
+		// save the gf matrix into file
+		saveMatrix(fileList[i], gf);
+	}
+}
@@ -0,0 +1,99 @@
+/*
+ * sparseSolver.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#ifndef SPARSESOLVER_H_
+#define SPARSESOLVER_H_
+
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../basis_set/basis.h"
+#include "../IO/MatrixIO.h"
+#include "sparseHamiltonian.h"
+
+/**
+ * Solve (z - H) x = e_initial with a sparse LU decomposition
+ *
+ * x is the column G(:, initial) of the Green's function. The sparse
+ * Hamiltonian, the fill-reducing ordering (COLAMD) and the symbolic
+ * factorization are computed once in the constructor, since the sparsity
+ * pattern of z - H doesn't depend on z. Only the numerical factorization has
+ * to be repeated for each z.
+ *
+ * before creating it, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+class SparseGreenSolver {
+public:
+	SparseGreenSolver(LatticeShape& lattice);
+
+	// the number of two-particle basis sets
+	int size() {
+		return basisSets.size();
+	}
+
+	// the position of a basis set in the solution vector
+	int position(Basis& basis) {
+		return getBasisPosition(*pLatticeShape, basis, basisIndex);
+	}
+
+	/**
+	 * factorize z - H (numerical factorization only)
+	 *
+	 * return false if the factorization fails
+	 */
+	bool factorize(dcomplex z);
+
+	/**
+	 * solve (z - H) x = e_initial with the last factorization
+	 */
+	void solveColumn(Basis& initialSites, CDVector& column);
+
+	/**
+	 * put the column G(:, initial) into a (xmax+1) x (xmax+1) matrix
+	 * gf(n1, n2) = gf(n2, n1) = G(n1, n2; initial), in the same format as
+	 * calculateAllGreenFunc
+	 */
+	void columnToMatrix(CDVector& column, CDMatrix& gf);
+
+private:
+	LatticeShape *pLatticeShape;
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DSparseMatrix hamiltonian;
+	CDSparseMatrix zMinusH;
+	std::vector<int> diagonalPosition; // the position of (i,i) in valuePtr()
+	Eigen::SparseLU<CDSparseMatrix, Eigen::COLAMDOrdering<int> > lu;
+};
+
+
+/**
+ * calculate <bra | G(z) | ket> for a list of z values with the sparse LU
+ * decomposition
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void greenFunc_sparse(LatticeShape& lattice, Basis& bra, Basis& ket,
+		              std::vector<dcomplex >& zList, std::vector<dcomplex>& gfList);
+
+/**
+ * calculate all Green's function G(n1, n2; initialSites) and save them into
+ * files (one file for each z)
+ *
+ * both functions stop the program if z - H cannot be factorized
+ *
+ * before calling this, call
+ * generateIndexMatrix(lattice);
+ * setLatticeAndInteractions(lattice, interactionData);
+ */
+void calculateAllGreenFunc_sparse(LatticeShape& lattice, Basis& initialSites,
+		                          std::vector<dcomplex >& zList,
+		                          std::vector<std::string>& fileList);
+
+#endif /* SPARSESOLVER_H_ */
@@ -0,0 +1,111 @@
+/*
+ * sparseSolver_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "sparseSolver.h"
+#include "../directCalculation/direct_calculation.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+
+
+/**
+ * compare an off-diagonal element with the direct calculation
+ */
+TEST(SparseSolverTest, CompareWithDirect) {
+	LatticeShape lattice1D(1);
+	int xmax = 30;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	InteractionData interactionData = {1.0,1.0,1.0,true,false,true,3,230,true,true};
+	generateIndexMatrix(lattice1D);
+	setLatticeAndInteractions(lattice1D, interactionData);
+
+	Basis initialSites(xmax/2, xmax/2+1);
+	Basis finalSites(xmax/2-5, xmax/2+2);
+
+	int size = 21;
+	std::vector<dcomplex > zList(size);
+	std::vector<double> zRealList = linspace(-10,10,size);
+	for (int i=0; i<zList.size(); ++i) {
+		zList[i] = dcomplex(zRealList[i], 0.05);
+	}
+
+	std::vector<dcomplex> gf_sparse;
+	std::vector<dcomplex> gf_direct;
+	greenFunc_sparse(lattice1D, finalSites, initialSites, zList, gf_sparse);
+	greenFunc_direct(lattice1D, finalSites, initialSites, zList, gf_direct);
+
+	EXPECT_EQ(gf_sparse.size(), gf_direct.size());
+	double abs_error = 1.e-9;
+	for (int i=0; i<gf_sparse.size(); ++i) {
+		EXPECT_NEAR(gf_sparse[i].real(), gf_direct[i].real(), abs_error);
+		EXPECT_NEAR(gf_sparse[i].imag(), gf_direct[i].imag(), abs_error);
+	}
+}
+
+
+/**
+ * compare all matrix elements with the recursive calculation
+ */
+TEST(SparseSolverTest, CompareAllWithRecursive) {
+	LatticeShape lattice1D(1);
+	int xmax = 61;
+	lattice1D.setXmax(xmax); //xsite = xmax + 1
+	Basis initialSites(xmax/2, xmax/2+1);
+
+	int maxDistance = 4;
+	InteractionData interactionData = {1.0,1.0,1.0,true,
+			false,false,maxDistance,230,true,true};
+	setUpIndexInteractions(lattice1D, interactionData);
+
+	std::vector<dcomplex> zList;
+	zList.push_back(dcomplex(0.5, 0.01));
+
+	std::vector< std::string > fileList_recur;
+	fileList_recur.push_back("GF_recur.bin");
+	calculateAllGreenFunc(lattice1D, initialSites, interactionData,
+			              zList, fileList_recur);
+
+	std::vector< std::string > fileList_sparse;
+	fileList_sparse.push_back("GF_sparse.bin");
+	calculateAllGreenFunc_sparse(lattice1D, initialSites, zList, fileList_sparse);
+
+	CDMatrix gf_recur;
+	loadMatrix(fileList_recur[0], gf_recur);
+	CDMatrix gf_sparse;
+	loadMatrix(fileList_sparse[0], gf_sparse);
+
+	EXPECT_EQ(gf_recur.rows(), gf_sparse.rows());
+	EXPECT_EQ(gf_recur.cols(), gf_sparse.cols());
+	EXPECT_NEAR((gf_recur - gf_sparse).norm(), 0.0, 1.e-9);
+}
+
+
+/**
+ * z at the only eigenvalue of a one-state lattice makes z - H singular
+ */
+TEST(SparseSolverTest, SingularStops) {
+	LatticeShape lattice1D(1);
+	lattice1D.setXmax(1);
+	InteractionData interactionData = {1.0,1.0,1.0,false,false,false,1,230,true,true};
+	generateIndexMatrix(lattice1D);
+	setLatticeAndInteractions(lattice1D, interactionData);
+
+	IMatrix basisIndex;
+	std::vector<Basis> basisSets;
+	DSparseMatrix hamiltonian;
+	formSparseHamiltonian(lattice1D, hamiltonian, basisIndex, basisSets);
+	ASSERT_EQ(hamiltonian.rows(), 1);
+	dcomplex eigenvalue = dcomplex(DMatrix(hamiltonian)(0, 0), 0.0);
+
+	SparseGreenSolver solver(lattice1D);
+	EXPECT_FALSE(solver.factorize(eigenvalue));
+
+	Basis sites(0, 1);
+	std::vector<dcomplex> zList(1, eigenvalue);
+	std::vector<dcomplex> gfList;
+	EXPECT_EXIT(greenFunc_sparse(lattice1D, sites, sites, zList, gfList),
+			    ::testing::ExitedWithCode(255), "");
+}
@@ -0,0 +1,251 @@
+/*
+ * transferMatrix.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "transferMatrix.h"
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+
+DisorderStream::DisorderStream(InteractionData& interactionData) {
+	onsiteE = interactionData.onsiteE;
+	random = interactionData.randomOnSite;
+	windowFirst = 0;
+	windowLast = INT_MAX;
+	clean = onsiteE;
+	first = 0;
+	// the same sequence as Interaction::setRandomVector
+	rng.SetSeed(interactionData.seed);
+}
+
+
+DisorderStream::DisorderStream(InteractionData& interactionData,
+		                       int windowFirst_, int windowLast_) {
+	onsiteE = interactionData.onsiteE;
+	random = interactionData.randomOnSite;
+	windowFirst = windowFirst_;
+	windowLast = windowLast_;
+	clean = random ? 0.0 : onsiteE;
+	first = windowFirst;
+	rng.SetSeed(interactionData.seed);
+}
+
+
+double DisorderStream::onsite(int x) {
+	if (x < windowFirst || x > windowLast) return clean;
+	if (x < first) {
+		std::cout << "The onsite energy of site " << x
+				  << " has been discarded" << std::endl;
+		exit(-1);
+	}
+	while (first + (int) window.size() <= x) {
+		double e = onsiteE;
+		if (random) {
+			e = onsiteE*(2*rng.randomReal()-1.0)/2;
+		}
+		window.push_back(e);
+	}
+	return window[x-first];
+}
+
+
+void DisorderStream::discardBelow(int x) {
+	while (first < x && !window.empty()) {
+		window.pop_front();
+		++first;
+	}
+}
+
+
+void setUpStrip(InteractionData& interactionData, int rMax, StripData& strip) {
+	if (interactionData.randomHop || interactionData.randomDyn) {
+		std::cout << "The transfer matrices only support random onsite energies"
+				  << std::endl;
+		exit(-1);
+	}
+	strip.step = interactionData.longRangeHop ? interactionData.maxDistance : 1;
+	strip.dynRange = interactionData.longRangeDyn ? interactionData.maxDistance : 1;
+	if (rMax < 2*strip.step || rMax%(2*strip.step) != 0) {
+		std::cout << "rMax = " << rMax << " must be a multiple of 2*" << strip.step
+				  << " so that beta_K can be inverted" << std::endl;
+		exit(-1);
+	}
+	strip.rMax = rMax;
+	strip.hop = interactionData.hop;
+	strip.dyn = interactionData.dyn;
+	strip.blockSize = strip.step*rMax/2;
+}
+
+
+/**
+ * the same matrix elements as formMatrixZ and formMatrixM with the constant
+ * t(i, i+n) = hop/n^3 and d(i, i+n) = dyn/n^3 of Interaction
+ */
+void formStripBlocks(const StripData& strip, DisorderStream& stream, int K,
+		             dcomplex z, CDMatrix& W, CDMatrix& Alpha, CDMatrix& Beta) {
+	int N = strip.blockSize;
+	int p = strip.step;
+	W = CDMatrix::Zero(N, N);
+	Alpha = CDMatrix::Zero(N, N);
+	Beta = CDMatrix::Zero(N, N);
+
+	for (int k=K; k<K+p; ++k) {
+		for (int r=(k%2==0 ? 2 : 1); r<=strip.rMax; r+=2) {
+			int x1 = (k-r)/2;
+			int x2 = (k+r)/2;
+			int row = stripIndex(strip, K, k, r);
+
+			double d = r<=strip.dynRange ? strip.dyn/std::pow(r, 3.0) : 0.0;
+			W(row, row) = z - stream.onsite(x1) - stream.onsite(x2) - d;
+
+			// move one of the particles by delta sites
+			for (int delta=-p; delta<=p; ++delta) {
+				if (delta==0) continue;
+				double t = strip.hop/std::pow(std::abs(delta), 3.0);
+				for (int particle=0; particle<2; ++particle) {
+					int y1 = particle==0 ? x1+delta : x1;
+					int y2 = particle==0 ? x2 : x2+delta;
+					if (y1==y2 || y1<0 || y2<0) continue;
+					int rNew = std::abs(y2-y1);
+					if (rNew > strip.rMax) continue;
+
+					int kNew = k + delta;
+					if (kNew < K) {
+						Alpha(row, stripIndex(strip, K-p, kNew, rNew)) = t;
+					} else if (kNew < K+p) {
+						W(row, stripIndex(strip, K, kNew, rNew)) = -t;
+					} else {
+						Beta(row, stripIndex(strip, K+p, kNew, rNew)) = t;
+					}
+				}
+			}
+		}
+	}
+}
+
+
+/**
+ * re-orthonormalize the columns of [top; bottom] and add log|R_ii| to logs
+ */
+static void reorthonormalize(CDMatrix& top, CDMatrix& bottom, std::vector<double>& logs) {
+	int N = top.rows();
+	CDMatrix Y(2*N, top.cols());
+	Y << top, bottom;
+	Eigen::HouseholderQR<CDMatrix> qr(Y);
+	CDMatrix R = qr.matrixQR().triangularView<Eigen::Upper>();
+	for (int i=0; i<R.cols(); ++i) {
+		logs[i] += std::log(std::abs(R(i, i)));
+	}
+	CDMatrix Q = qr.householderQ()*CDMatrix::Identity(2*N, top.cols());
+	top = Q.topRows(N);
+	bottom = Q.bottomRows(N);
+}
+
+
+void lyapunovExponents(InteractionData& interactionData,
+		               TransferMatrixData& transferMatrixData,
+		               LyapunovResult& result) {
+	StripData strip;
+	setUpStrip(interactionData, transferMatrixData.rMax, strip);
+	int N = strip.blockSize;
+	int p = strip.step;
+	int qrInterval = max(transferMatrixData.qrInterval, 1);
+	int numSegments = max(transferMatrixData.numSegments, 1);
+	int measuredBlocks = transferMatrixData.numBlocks - transferMatrixData.warmupBlocks;
+	if (measuredBlocks < numSegments) {
+		std::cout << "The chain is too short for " << numSegments
+				  << " segments" << std::endl;
+		exit(-1);
+	}
+
+	DisorderStream stream(interactionData);
+
+	// all the 2N directions: [V_K; V_{K-p}] for every column
+	CDMatrix top = CDMatrix::Identity(N, 2*N);
+	CDMatrix bottom = CDMatrix::Zero(N, 2*N);
+	bottom.rightCols(N) = CDMatrix::Identity(N, N);
+
+	std::vector<double> logs(2*N, 0.0);
+	// log|R_ii| and the number of blocks of every segment
+	std::vector< std::vector<double> > segmentLogs(numSegments,
+			std::vector<double>(2*N, 0.0));
+	std::vector<int> segmentBlocks(numSegments, 0);
+	int blocksSinceQR = 0;
+
+	// the first block whose elements all have x1 >= 0
+	int KStart = strip.rMax;
+	for (int block=0; block<transferMatrixData.numBlocks; ++block) {
+		int K = KStart + block*p;
+		CDMatrix W, Alpha, Beta;
+		formStripBlocks(strip, stream, K, transferMatrixData.z, W, Alpha, Beta);
+		// the sites left of the next block are no longer needed
+		stream.discardBelow((K+p-strip.rMax)/2);
+
+		Eigen::FullPivLU<CDMatrix> lu(Beta);
+		if (!lu.isInvertible()) {
+			std::cout << "beta_K is singular at K = " << K << std::endl;
+			exit(-1);
+		}
+		CDMatrix newTop = lu.solve(W*top - Alpha*bottom);
+		bottom = top;
+		top = newTop;
+		++blocksSinceQR;
+
+		bool endOfWarmup = block+1==transferMatrixData.warmupBlocks;
+		if (blocksSinceQR==qrInterval || endOfWarmup
+				|| block+1==transferMatrixData.numBlocks) {
+			std::vector<double> stepLogs(2*N, 0.0);
+			reorthonormalize(top, bottom, stepLogs);
+			if (block >= transferMatrixData.warmupBlocks) {
+				int measured = block + 1 - transferMatrixData.warmupBlocks;
+				int segment = min((measured-1)*numSegments/measuredBlocks,
+						numSegments-1);
+				for (int i=0; i<2*N; ++i) {
+					logs[i] += stepLogs[i];
+					segmentLogs[segment][i] += stepLogs[i];
+				}
+				segmentBlocks[segment] += blocksSinceQR;
+			}
+			blocksSinceQR = 0;
+		}
+	}
+
+	// every block moves the center of mass by p/2 lattice constants
+	double length = 0.5*p*measuredBlocks;
+	result.exponents.resize(2*N);
+	for (int i=0; i<2*N; ++i) {
+		result.exponents[i] = logs[i]/length;
+	}
+	std::sort(result.exponents.begin(), result.exponents.end(),
+			std::greater<double>());
+	result.inverseLocalizationLength = result.exponents[N-1];
+
+	// the spread of the same exponent over the segments
+	std::vector<double> estimates;
+	for (int s=0; s<numSegments; ++s) {
+		if (segmentBlocks[s]==0) continue;
+		std::vector<double> e(2*N);
+		for (int i=0; i<2*N; ++i) {
+			e[i] = segmentLogs[s][i]/(0.5*p*segmentBlocks[s]);
+		}
+		std::sort(e.begin(), e.end(), std::greater<double>());
+		estimates.push_back(e[N-1]);
+	}
+	result.error = 0.0;
+	int M = estimates.size();
+	if (M > 1) {
+		double mean = 0.0;
+		for (int s=0; s<M; ++s) mean += estimates[s];
+		mean /= M;
+		double variance = 0.0;
+		for (int s=0; s<M; ++s) {
+			variance += (estimates[s]-mean)*(estimates[s]-mean);
+		}
+		variance /= (M-1);
+		result.error = std::sqrt(variance/M);
+	}
+}
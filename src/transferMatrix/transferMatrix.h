@@ -0,0 +1,141 @@
+/*
+ * transferMatrix.h
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ *
+ * Two-particle localization length from the smallest Lyapunov exponent of
+ * the transfer matrices along K.
+ *
+ * The two particles are kept on a strip: their distance r = x2 - x1 is
+ * limited to 1 <= r <= rMax (beyond which G is negligible for a bound pair).
+ * Then v_K, the Green's functions with x1 + x2 = K, always has rMax/2
+ * elements (r = K mod 2), all the blocks
+ *
+ *       V_{K} = [v_{K}, v_{K+1}, ..., v_{K+p-1}],   p = range of hopping
+ *
+ * have the same size N = p*rMax/2, and the recursion
+ *
+ *       W_{K}*V_{K} = alpha_{K}*V_{K-p} + beta_{K}*V_{K+p}
+ *
+ * can be written as a transfer matrix
+ *
+ *       / V_{K+p} \     / beta_K^{-1} W_K   -beta_K^{-1} alpha_K \ / V_{K}   \
+ *       |         |  =  |                                         | |         |
+ *       \ V_{K}   /     \       I                    0            / \ V_{K-p} /
+ *
+ * beta_K is block lower triangular and its diagonal blocks only contain the
+ * moves by exactly p sites; it is invertible when rMax is a multiple of 2p.
+ *
+ * The chain starts at site 0 and is as long as needed: the onsite energies
+ * are drawn when the recursion reaches them and dropped behind it, so the
+ * memory does not depend on the length of the chain.
+ */
+
+#ifndef TRANSFERMATRIX_H_
+#define TRANSFERMATRIX_H_
+
+#include <deque>
+#include <climits>
+#include <vector>
+#include "../Utility/types.h"
+#include "../Utility/misc.h"
+#include "../Utility/random_generator.h"
+#include "../formMatrix/formMatrix.h"
+
+
+/**
+ * the onsite energies e(0), e(1), ... of a chain of any length
+ *
+ * They are drawn in the same way and order as in the Interaction class, so
+ * the first xmax+1 values are the same as those of an Interaction with the
+ * same InteractionData. Because both use rand(), only one stream (or
+ * Interaction) may draw numbers at a time.
+ */
+class DisorderStream {
+public:
+	DisorderStream(InteractionData& interactionData);
+
+	/**
+	 * only the sites windowFirst <= x <= windowLast are disordered (drawn in
+	 * the same order starting from windowFirst); the others have the clean
+	 * onsite energy, 0 for random onsite energies and onsiteE otherwise
+	 */
+	DisorderStream(InteractionData& interactionData, int windowFirst, int windowLast);
+
+	// x must not be below the sites that have been discarded
+	double onsite(int x);
+
+	// forget the energies of the sites below x
+	void discardBelow(int x);
+
+	int size() { return window.size(); }
+
+private:
+	double onsiteE;
+	bool random;
+	int windowFirst, windowLast;
+	double clean; // the onsite energy outside the window
+	int first; // the site of window.front()
+	std::deque<double> window;
+	RandomNumberGenerator rng;
+};
+
+
+typedef struct {
+	int rMax; // the largest distance between the two particles
+	int step; // p, the block step (= range of hopping)
+	int dynRange;
+	double hop, dyn;
+	int blockSize; // N = p*rMax/2
+} StripData;
+
+
+typedef struct {
+	int rMax;
+	dcomplex z;
+	int numBlocks; // the length of the chain in units of p along K
+	int warmupBlocks; // blocks that are discarded before the exponents are accumulated
+	int qrInterval; // re-orthonormalize every qrInterval blocks
+	int numSegments; // the run is cut into segments for the error estimate
+} TransferMatrixData;
+
+
+typedef struct {
+	// the 2N exponents in decreasing order, per lattice constant of the
+	// center of mass (K/2), the same unit as |n-m| in
+	// << ln|<m, m+a|G(z)|n, n+a>| >> = - |n-m|/localization_length
+	std::vector<double> exponents;
+	double inverseLocalizationLength; // the smallest positive one, exponents[N-1]
+	double error; // standard error of inverseLocalizationLength over the segments
+} LyapunovResult;
+
+
+/**
+ * check the interaction and the strip width; only the onsite energies may
+ * be random since t and d are not stored for the whole chain
+ */
+void setUpStrip(InteractionData& interactionData, int rMax, StripData& strip);
+
+/**
+ * the position of the element (x1, x2) = ((k-r)/2, (k+r)/2) in V_K
+ */
+inline int stripIndex(const StripData& strip, int K, int k, int r) {
+	return (k-K)*(strip.rMax/2) + (r-1)/2;
+}
+
+/**
+ * W_K, alpha_K and beta_K of the strip (all of them N x N)
+ */
+void formStripBlocks(const StripData& strip, DisorderStream& stream, int K,
+		             dcomplex z, CDMatrix& W, CDMatrix& Alpha, CDMatrix& Beta);
+
+/**
+ * iterate the transfer matrices along the chain with a QR decomposition
+ * every qrInterval blocks and return all the Lyapunov exponents
+ */
+void lyapunovExponents(InteractionData& interactionData,
+		               TransferMatrixData& transferMatrixData,
+		               LyapunovResult& result);
+
+#endif /* TRANSFERMATRIX_H_ */
@@ -0,0 +1,125 @@
+/*
+ * transferMatrix_test.cpp
+ *
+ *  Created on: Oct 20, 2026
+ *      Author: pxiang
+ */
+
+#include "gtest/gtest.h"
+#include "transferMatrix.h"
+#include "../recursiveCalculation/recursiveCalculation.h"
+
+
+TEST(DisorderStream, SameAsInteraction) {
+	LatticeShape lattice1D(1);
+	int xmax = 80;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {2.5, 1.0, 1.0, true, false, false, 2, 17,
+			                           true, true};
+	setUpIndexInteractions(lattice1D, interactionData);
+
+	DisorderStream stream(interactionData);
+	for (int i=0; i<=xmax; ++i) {
+		EXPECT_EQ(stream.onsite(i), eVector(*pInteraction, i));
+		// keep only a few sites as the recursion does
+		stream.discardBelow(i-3);
+	}
+	EXPECT_LE(stream.size(), 4);
+}
+
+
+TEST(FormStripBlocks, SameAsFullLattice) {
+	LatticeShape lattice1D(1);
+	int xmax = 60;
+	lattice1D.setXmax(xmax);
+	InteractionData interactionData = {2.5, 1.0, 0.7, true, false, false, 2, 23,
+			                           true, true};
+	setUpIndexInteractions(lattice1D, interactionData);
+
+	StripData strip;
+	int rMax = 8;
+	setUpStrip(interactionData, rMax, strip);
+	ASSERT_EQ(strip.step, 2);
+	ASSERT_EQ(strip.blockSize, 8);
+
+	dcomplex z(0.3, 0.01);
+	// an interior block that is also a block of the full lattice (K = 1 + j*p)
+	int K = 41;
+	DisorderStream stream(interactionData);
+	CDMatrix W, Alpha, Beta;
+	formStripBlocks(strip, stream, K, z, W, Alpha, Beta);
+
+	CDMatrix WFull, AlphaFull, BetaFull;
+	formMatrixW(K, z, WFull);
+	formMatrixAlpha(K, AlphaFull);
+	formMatrixBeta(K, BetaFull);
+
+	// the strip elements of V_{K-p}, V_K and V_{K+p} in the full lattice
+	int p = strip.step;
+	std::vector<int> rowsOf[3];
+	for (int b=0; b<3; ++b) {
+		int KB = K + (b-1)*p;
+		rowsOf[b].resize(strip.blockSize);
+		for (int k=KB; k<KB+p; ++k) {
+			for (int r=(k%2==0 ? 2 : 1); r<=rMax; r+=2) {
+				Basis basis((k-r)/2, (k+r)/2);
+				rowsOf[b][stripIndex(strip, KB, k, r)] = getBasisIndexInVK(lattice1D, KB, basis);
+			}
+		}
+	}
+
+	for (int i=0; i<strip.blockSize; ++i) {
+		for (int j=0; j<strip.blockSize; ++j) {
+			EXPECT_NEAR(std::abs(W(i,j) - WFull(rowsOf[1][i], rowsOf[1][j])), 0.0, 1e-12);
+			EXPECT_NEAR(std::abs(Alpha(i,j) - AlphaFull(rowsOf[1][i], rowsOf[0][j])), 0.0, 1e-12);
+			EXPECT_NEAR(std::abs(Beta(i,j) - BetaFull(rowsOf[1][i], rowsOf[2][j])), 0.0, 1e-12);
+		}
+	}
+}
+
+
+TEST(LyapunovExponents, CleanChain) {
+	// rMax = 2: a single chain of the states (x, x+1), (x, x+2), (x+1, x+2), ...
+	// with hopping 1 along k, so G ~ exp(-acosh(E/2)*k)
+	InteractionData interactionData = {0.0, 1.0, 0.0, false, false, false, 1, 1,
+			                           false, false};
+	TransferMatrixData transferMatrixData;
+	transferMatrixData.rMax = 2;
+	transferMatrixData.z = dcomplex(3.0, 0.0);
+	transferMatrixData.numBlocks = 400;
+	transferMatrixData.warmupBlocks = 50;
+	transferMatrixData.qrInterval = 5;
+	transferMatrixData.numSegments = 5;
+
+	LyapunovResult result;
+	lyapunovExponents(interactionData, transferMatrixData, result);
+	ASSERT_EQ(result.exponents.size(), 2);
+	double gamma = 2*std::log(1.5 + std::sqrt(1.5*1.5-1));
+	EXPECT_NEAR(result.inverseLocalizationLength, gamma, 1e-6);
+	EXPECT_NEAR(result.exponents[1], -gamma, 1e-6);
+}
+
+
+TEST(LyapunovExponents, SymmetricSpectrum) {
+	// H is real and symmetric, so the exponents come in pairs +gamma, -gamma
+	InteractionData interactionData = {2.0, 1.0, 1.0, true, false, false, 2, 5,
+			                           true, true};
+	TransferMatrixData transferMatrixData;
+	transferMatrixData.rMax = 4;
+	transferMatrixData.z = dcomplex(0.5, 0.0);
+	transferMatrixData.numBlocks = 4000;
+	transferMatrixData.warmupBlocks = 100;
+	transferMatrixData.qrInterval = 4;
+	transferMatrixData.numSegments = 10;
+
+	LyapunovResult result;
+	lyapunovExponents(interactionData, transferMatrixData, result);
+	int N = result.exponents.size()/2;
+	ASSERT_EQ(N, 4);
+	for (int i=0; i<N; ++i) {
+		EXPECT_NEAR(result.exponents[i], -result.exponents[2*N-1-i], 0.05);
+	}
+	EXPECT_GT(result.inverseLocalizationLength, 0.0);
+	EXPECT_GT(result.error, 0.0);
+	EXPECT_LT(result.error, 0.1*result.inverseLocalizationLength);
+}